@@ -2,45 +2,37 @@
 // Created by egork on 27.10.2020.
 //
 #include <iostream>
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include <thread>
 
 using Coordinate = int;
 
-enum Orientation : int {
-  CounterClockwise = -1,
-  SameAngle = 0,
-  Clockwise = 1
-};
-
 struct Vector {
   Coordinate x;
   Coordinate y;
+};
 
-  Coordinate Dot(const Vector &other) const {
-    return x * other.x + y * other.y;
-  }
+// Sign of (b - a) x (c - a). Differences of ints take 33 bits, and their products fit in 64 bits
+// only while the differences are below 2^31, the wider ones are multiplied in __int128
+int OrientSign(const Vector &a, const Vector &b, const Vector &c) {
+  int64_t ux = int64_t(b.x) - a.x, uy = int64_t(b.y) - a.y;
+  int64_t vx = int64_t(c.x) - a.x, vy = int64_t(c.y) - a.y;
+  auto fits = [](int64_t value) { return -(int64_t(1) << 31) < value && value < (int64_t(1) << 31); };
 
-  Coordinate Cross(const Vector &other) const {
-    return x * other.y - y * other.x;
+  if (fits(ux) && fits(uy) && fits(vx) && fits(vy)) {
+    int64_t value = ux * vy - uy * vx;
+    return (value > 0) - (value < 0);
   }
 
-  Orientation Orient(const Vector &other) const {
-    Coordinate prod = Cross(other);
-
-    if (prod > 0)
-      return Clockwise;
-    else if (prod < 0)
-      return CounterClockwise;
-    else
-      return SameAngle;
-  }
-};
-
-Vector operator-(const Vector &left, const Vector &right) {
-  return {left.x - right.x, left.y - right.y};
-}
-
-Vector operator+(const Vector &left, const Vector &right) {
-  return {left.x + right.x, left.y + right.y};
+  __int128 value = static_cast<__int128>(ux) * vy - static_cast<__int128>(uy) * vx;
+  return (value > 0) - (value < 0);
 }
 
 struct Segment {
@@ -63,41 +55,348 @@ struct Segment {
     return std::max(start.y, end.y);
   }
 
-  Vector Dir() const {
-    return end - start;
-  }
-
   bool Intersects(const Segment &other) const {
     if (HighX() < other.LowX() || other.HighX() < LowX() || HighY() < other.LowY()
         || other.HighY() < LowY())
       return false;
 
-    return Dir().Orient(other.start - start) * Dir().Orient(other.end - start) <= 0
-        && other.Dir().Orient(start - other.start) * other.Dir().Orient(end - other.start) <= 0;
+    return OrientSign(start, end, other.start) * OrientSign(start, end, other.end) <= 0
+        && OrientSign(other.start, other.end, start) * OrientSign(other.start, other.end, end) <= 0;
+  }
+};
+
+// Parses integers by hand from big blocks of the input, which is a lot faster than std::cin
+class InputReader {
+ public:
+  explicit InputReader(std::FILE *in) : in_(in) {}
+
+  template<typename Integer>
+  Integer ReadInteger() {
+    int c = SkipSpaces();
+    bool negative = c == '-';
+
+    if (negative)
+      c = NextChar();
+
+    Integer value = 0;
+
+    // Accumulated with the sign, so that the minimum of a signed type doesn't overflow
+    for (; '0' <= c && c <= '9'; c = NextChar())
+      value = negative ? value * 10 - (c - '0') : value * 10 + (c - '0');
+
+    return value;
+  }
+
+  // Fixed width little-endian integer, the binary input is made of int64 only
+  int64_t ReadBinaryInteger() {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); ++i)
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(NextChar())) << (8 * i);
+
+    return static_cast<int64_t>(value);
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  int NextChar() {
+    if (position_ == size_) {
+      size_ = std::fread(buffer_, 1, kBufferSize, in_);
+      position_ = 0;
+
+      if (size_ == 0)
+        return EOF;
+    }
+
+    return buffer_[position_++];
+  }
+
+  int SkipSpaces() {
+    int c = NextChar();
+
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+      c = NextChar();
+
+    return c;
+  }
+
+  std::FILE *in_;
+  char buffer_[kBufferSize];
+  size_t position_ = 0;
+  size_t size_ = 0;
+};
+
+Segment ReadSegment(InputReader &reader) {
+  Coordinate sx = reader.ReadInteger<Coordinate>();
+  Coordinate sy = reader.ReadInteger<Coordinate>();
+  Coordinate ex = reader.ReadInteger<Coordinate>();
+  Coordinate ey = reader.ReadInteger<Coordinate>();
+  return {{sx, sy}, {ex, ey}};
+}
+
+// Binary: u64 count, then little-endian int64 x and y for every point
+std::vector<Vector> ReadBinaryPoints(InputReader &reader) {
+  std::vector<Vector> points(reader.ReadBinaryInteger());
+
+  for (Vector &p : points) {
+    p.x = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    p.y = static_cast<Coordinate>(reader.ReadBinaryInteger());
+  }
+
+  return points;
+}
+
+// Struct of arrays, so that the batch kernel runs over contiguous coordinates
+struct SegmentBuffer {
+  void Reserve(size_t size) {
+    start_x.reserve(size);
+    start_y.reserve(size);
+    end_x.reserve(size);
+    end_y.reserve(size);
+  }
+
+  void PushBack(const Segment &segment) {
+    start_x.push_back(segment.start.x);
+    start_y.push_back(segment.start.y);
+    end_x.push_back(segment.end.x);
+    end_y.push_back(segment.end.y);
+    low = std::min({low, segment.LowX(), segment.LowY()});
+    high = std::max({high, segment.HighX(), segment.HighY()});
+  }
+
+  size_t Size() const { return start_x.size(); }
+
+  std::vector<Coordinate> start_x;
+  std::vector<Coordinate> start_y;
+  std::vector<Coordinate> end_x;
+  std::vector<Coordinate> end_y;
+  // bounds of all the coordinates
+  Coordinate low = std::numeric_limits<Coordinate>::max();
+  Coordinate high = std::numeric_limits<Coordinate>::min();
+};
+
+template<typename Product>
+int Sign(Product value) {
+  return (value > 0) - (value < 0);
+}
+
+// Same predicate as Segment::Intersects, but without branches, so the loop can be vectorized.
+// Product has to hold a difference of products of two coordinate differences
+template<typename Product>
+size_t CountIntersections(const Segment &path, const SegmentBuffer &segments, size_t from, size_t to) {
+  Product px = path.start.x;
+  Product py = path.start.y;
+  Product pdx = Product(path.end.x) - px;
+  Product pdy = Product(path.end.y) - py;
+  Coordinate low_x = path.LowX();
+  Coordinate high_x = path.HighX();
+  Coordinate low_y = path.LowY();
+  Coordinate high_y = path.HighY();
+  size_t intersects = 0;
+
+  for (size_t i = from; i < to; ++i) {
+    Product sx = segments.start_x[i];
+    Product sy = segments.start_y[i];
+    Product ex = segments.end_x[i];
+    Product ey = segments.end_y[i];
+    Product sdx = ex - sx;
+    Product sdy = ey - sy;
+
+    int start_side = Sign(pdx * (sy - py) - pdy * (sx - px));
+    int end_side = Sign(pdx * (ey - py) - pdy * (ex - px));
+    int path_start_side = Sign(sdx * (py - sy) - sdy * (px - sx));
+    int path_end_side = Sign(sdx * (py + pdy - sy) - sdy * (px + pdx - sx));
+
+    bool boxes_intersect = (std::max(segments.start_x[i], segments.end_x[i]) >= low_x)
+        & (std::min(segments.start_x[i], segments.end_x[i]) <= high_x)
+        & (std::max(segments.start_y[i], segments.end_y[i]) >= low_y)
+        & (std::min(segments.start_y[i], segments.end_y[i]) <= high_y);
+
+    intersects += boxes_intersect & (start_side * end_side <= 0) & (path_start_side * path_end_side <= 0);
+  }
+
+  return intersects;
+}
+
+// Differences are bounded by the span of all the coordinates and products of two of them are
+// subtracted, so 64 bits are enough, while the span is below 2^31
+bool FitsInt64(const Segment &path, const SegmentBuffer &segments) {
+  int64_t low = std::min({segments.low, path.LowX(), path.LowY()});
+  int64_t high = std::max({segments.high, path.HighX(), path.HighY()});
+  return high - low < (int64_t(1) << 31);
+}
+
+size_t CountIntersections(const Segment &path, const SegmentBuffer &segments) {
+  if (FitsInt64(path, segments))
+    return CountIntersections<int64_t>(path, segments, 0, segments.Size());
+  else
+    return CountIntersections<__int128>(path, segments, 0, segments.Size());
+}
+
+struct Box {
+  Coordinate low_x = std::numeric_limits<Coordinate>::max();
+  Coordinate low_y = std::numeric_limits<Coordinate>::max();
+  Coordinate high_x = std::numeric_limits<Coordinate>::min();
+  Coordinate high_y = std::numeric_limits<Coordinate>::min();
+
+  void Extend(const Box &other) {
+    low_x = std::min(low_x, other.low_x);
+    low_y = std::min(low_y, other.low_y);
+    high_x = std::max(high_x, other.high_x);
+    high_y = std::max(high_y, other.high_y);
+  }
+
+  bool Intersects(const Box &other) const {
+    return low_x <= other.high_x && other.low_x <= high_x && low_y <= other.high_y && other.low_y <= high_y;
   }
 };
 
-std::istream &operator>>(std::istream &in, Segment &segment) {
-  Coordinate sx, sy, ex, ey;
-  in >> sx >> sy >> ex >> ey;
-  segment = {{sx, sy}, {ex, ey}};
-  return in;
+Box BoundingBox(const Segment &segment) {
+  return {segment.LowX(), segment.LowY(), segment.HighX(), segment.HighY()};
+}
+
+// Packed R-tree, bulk loaded with Sort-Tile-Recursive: segments are cut into vertical slices
+// by the x of their centers, each slice is sorted by y and consecutive kFanout segments form a leaf.
+// Leaves are ranges of the sorted segment buffer, so they are checked with the batch kernel
+class SegmentIndex {
+ public:
+  explicit SegmentIndex(std::vector<Segment> segments);
+
+  size_t CountIntersections(const Segment &path) const;
+  // Queries are spread over the threads, answers are in the order of the queries
+  std::vector<size_t> CountIntersections(const std::vector<Segment> &paths, size_t threads_count) const;
+
+ private:
+  static constexpr size_t kFanout = 16;
+
+  template<typename Product>
+  size_t CountIntersectionsWith(const Segment &path) const;
+
+  SegmentBuffer segments_;
+  // levels_[0][i] bounds segments [i * kFanout, (i + 1) * kFanout),
+  // levels_[l][i] bounds boxes [i * kFanout, (i + 1) * kFanout) of levels_[l - 1]
+  std::vector<std::vector<Box>> levels_;
+};
+
+SegmentIndex::SegmentIndex(std::vector<Segment> segments) {
+  // Doubled centers, to stay in integers
+  auto center_x = [](const Segment &s) { return int64_t(s.start.x) + s.end.x; };
+  auto center_y = [](const Segment &s) { return int64_t(s.start.y) + s.end.y; };
+
+  size_t leaves = (segments.size() + kFanout - 1) / kFanout;
+  size_t slices = std::max<size_t>(1, std::ceil(std::sqrt(double(leaves))));
+  size_t slice_size = ((leaves + slices - 1) / slices) * kFanout;
+
+  std::sort(segments.begin(), segments.end(), [&](const Segment &left, const Segment &right) {
+    return center_x(left) < center_x(right);
+  });
+
+  for (size_t from = 0; from < segments.size(); from += slice_size)
+    std::sort(segments.begin() + from,
+              segments.begin() + std::min(from + slice_size, segments.size()),
+              [&](const Segment &left, const Segment &right) {
+                return center_y(left) < center_y(right);
+              });
+
+  segments_.Reserve(segments.size());
+  levels_.emplace_back(leaves);
+
+  for (size_t i = 0; i < segments.size(); ++i) {
+    segments_.PushBack(segments[i]);
+    levels_[0][i / kFanout].Extend(BoundingBox(segments[i]));
+  }
+
+  while (levels_.back().size() > 1) {
+    const std::vector<Box> &below = levels_.back();
+    std::vector<Box> level((below.size() + kFanout - 1) / kFanout);
+
+    for (size_t i = 0; i < below.size(); ++i)
+      level[i / kFanout].Extend(below[i]);
+
+    levels_.push_back(std::move(level));
+  }
+}
+
+template<typename Product>
+size_t SegmentIndex::CountIntersectionsWith(const Segment &path) const {
+  if (segments_.Size() == 0)
+    return 0;
+
+  Box path_box = BoundingBox(path);
+  size_t intersects = 0;
+  //                    level , index
+  std::vector<std::pair<size_t, size_t>> stack{{levels_.size() - 1, 0}};
+
+  while (!stack.empty()) {
+    auto[level, index] = stack.back();
+    stack.pop_back();
+
+    if (!levels_[level][index].Intersects(path_box))
+      continue;
+
+    size_t from = index * kFanout;
+
+    if (level == 0) {
+      intersects += ::CountIntersections<Product>(
+          path, segments_, from, std::min(from + kFanout, segments_.Size()));
+    } else {
+      for (size_t child = from; child < std::min(from + kFanout, levels_[level - 1].size()); ++child)
+        stack.emplace_back(level - 1, child);
+    }
+  }
+
+  return intersects;
+}
+
+size_t SegmentIndex::CountIntersections(const Segment &path) const {
+  if (FitsInt64(path, segments_))
+    return CountIntersectionsWith<int64_t>(path);
+  else
+    return CountIntersectionsWith<__int128>(path);
+}
+
+std::vector<size_t> SegmentIndex::CountIntersections(const std::vector<Segment> &paths,
+                                                     size_t threads_count) const {
+  std::vector<size_t> result(paths.size());
+  std::atomic<size_t> next_path{0};
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < std::max<size_t>(threads_count, 1); ++i)
+    threads.emplace_back([&]() {
+      for (size_t path = next_path++; path < paths.size(); path = next_path++)
+        result[path] = CountIntersections(paths[path]);
+    });
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  return result;
 }
 
-int main() {
+// With --binary the input is a single block of ReadBinaryPoints: the ends of the path, then the ends of every river
+int main(int argc, char **argv) {
+  InputReader reader(stdin);
   Segment path;
-  std::cin >> path;
+  SegmentBuffer rivers;
 
-  int n;
-  std::cin >> n;
+  if (argc > 1 && std::string(argv[1]) == "--binary") {
+    std::vector<Vector> ends = ReadBinaryPoints(reader);
+    // A missing path is at the origin, as in an empty text input, and an unpaired last end is dropped
+    ends.resize(std::max<size_t>(2, ends.size()) / 2 * 2);
+    path = {ends[0], ends[1]};
+    rivers.Reserve(ends.size() / 2 - 1);
 
-  int intersects = 0;
+    for (size_t i = 2; i < ends.size(); i += 2)
+      rivers.PushBack({ends[i], ends[i + 1]});
+  } else {
+    path = ReadSegment(reader);
+    int n = reader.ReadInteger<int>();
+    rivers.Reserve(n);
 
-  for (int i = 0; i < n; ++i) {
-    Segment river;
-    std::cin >> river;
-    intersects += path.Intersects(river);
+    for (int i = 0; i < n; ++i)
+      rivers.PushBack(ReadSegment(reader));
   }
 
-  std::cout << intersects << '\n';
+  std::cout << CountIntersections(path, rivers) << '\n';
 }
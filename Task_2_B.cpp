@@ -2,14 +2,35 @@
 // Created by egork on 27.10.2020.
 //
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
 #include <vector>
+#include <string>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <limits>
+#include <array>
+#include <map>
+#include <thread>
 #include <iomanip>
 
 using Coordinate = long long;
 
+// Sign of a * b - c * d. The products can't overflow 64 bits while all the factors are below 2^31
+// by absolute value, which is the usual case, otherwise they are taken in __int128
+int ProductDifferenceSign(Coordinate a, Coordinate b, Coordinate c, Coordinate d) {
+  auto fits = [](Coordinate value) { return static_cast<uint64_t>(value) + (uint64_t(1) << 31) < (uint64_t(1) << 32); };
+
+  if (fits(a) && fits(b) && fits(c) && fits(d)) {
+    int64_t value = int64_t(a) * b - int64_t(c) * d;
+    return (value > 0) - (value < 0);
+  }
+
+  __int128 value = static_cast<__int128>(a) * b - static_cast<__int128>(c) * d;
+  return (value > 0) - (value < 0);
+}
+
 enum Orientation : int {
   CounterClockwise = -1,
   SameAngle = 0,
@@ -20,27 +41,17 @@ struct Vector {
   Coordinate x;
   Coordinate y;
 
-  Coordinate SqrDist() const { return x * x + y * y; }
+  __int128 SqrDist() const { return static_cast<__int128>(x) * x + static_cast<__int128>(y) * y; }
 
-  double Dist() const { return std::sqrt(x * x + y * y); }
+  double Dist() const { return std::hypot(static_cast<double>(x), static_cast<double>(y)); }
 
   Coordinate Dot(const Vector &other) const {
     return x * other.x + y * other.y;
   }
 
-  Coordinate Cross(const Vector &other) const {
-    return x * other.y - y * other.x;
-  }
-
+  // Sign of the cross product
   Orientation Orient(const Vector &other) const {
-    Coordinate prod = Cross(other);
-
-    if (prod > 0)
-      return Clockwise;
-    else if (prod < 0)
-      return CounterClockwise;
-    else
-      return SameAngle;
+    return static_cast<Orientation>(ProductDifferenceSign(x, other.y, y, other.x));
   }
 
   bool operator==(const Vector &other) const {
@@ -56,6 +67,92 @@ Vector operator+(const Vector &left, const Vector &right) {
   return {left.x + right.x, left.y + right.y};
 }
 
+// Parses integers by hand from big blocks of the input, which is a lot faster than std::cin
+class InputReader {
+ public:
+  explicit InputReader(std::FILE *in) : in_(in) {}
+
+  template<typename Integer>
+  Integer ReadInteger() {
+    int c = SkipSpaces();
+    bool negative = c == '-';
+
+    if (negative)
+      c = NextChar();
+
+    Integer value = 0;
+
+    // Accumulated with the sign, so that the minimum of a signed type doesn't overflow
+    for (; '0' <= c && c <= '9'; c = NextChar())
+      value = negative ? value * 10 - (c - '0') : value * 10 + (c - '0');
+
+    return value;
+  }
+
+  // Fixed width little-endian integer, the binary input is made of int64 only
+  int64_t ReadBinaryInteger() {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); ++i)
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(NextChar())) << (8 * i);
+
+    return static_cast<int64_t>(value);
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  int NextChar() {
+    if (position_ == size_) {
+      size_ = std::fread(buffer_, 1, kBufferSize, in_);
+      position_ = 0;
+
+      if (size_ == 0)
+        return EOF;
+    }
+
+    return buffer_[position_++];
+  }
+
+  int SkipSpaces() {
+    int c = NextChar();
+
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+      c = NextChar();
+
+    return c;
+  }
+
+  std::FILE *in_;
+  char buffer_[kBufferSize];
+  size_t position_ = 0;
+  size_t size_ = 0;
+};
+
+// Text: "x y" for every point
+std::vector<Vector> ReadPoints(InputReader &reader, size_t n) {
+  std::vector<Vector> points(n);
+
+  for (Vector &p : points) {
+    p.x = reader.ReadInteger<Coordinate>();
+    p.y = reader.ReadInteger<Coordinate>();
+  }
+
+  return points;
+}
+
+// Binary: u64 count, then little-endian int64 x and y for every point
+std::vector<Vector> ReadBinaryPoints(InputReader &reader) {
+  std::vector<Vector> points(reader.ReadBinaryInteger());
+
+  for (Vector &p : points) {
+    p.x = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    p.y = static_cast<Coordinate>(reader.ReadBinaryInteger());
+  }
+
+  return points;
+}
+
 std::vector<Vector> BuildConvexHull(std::vector<Vector> points) {
   Vector lowest = *std::min_element(
       points.begin(), points.end(),
@@ -90,6 +187,206 @@ std::vector<Vector> BuildConvexHull(std::vector<Vector> points) {
   return hull;
 }
 
+// Points with 32-bit coordinates are packed into keys, which sort in (x, y) order as plain integers
+bool FitsInt32(const std::vector<Vector> &points) {
+  return std::all_of(points.begin(), points.end(), [](const Vector &p) {
+    return std::numeric_limits<int32_t>::min() <= std::min(p.x, p.y)
+        && std::max(p.x, p.y) <= std::numeric_limits<int32_t>::max();
+  });
+}
+
+uint64_t PackPoint(const Vector &p) {
+  return (static_cast<uint64_t>(p.x - std::numeric_limits<int32_t>::min()) << 32)
+      | static_cast<uint64_t>(p.y - std::numeric_limits<int32_t>::min());
+}
+
+Vector UnpackPoint(uint64_t key) {
+  return {static_cast<Coordinate>(key >> 32) + std::numeric_limits<int32_t>::min(),
+          static_cast<Coordinate>(key & 0xffffffffull) + std::numeric_limits<int32_t>::min()};
+}
+
+// LSD radix sort by 16-bit digits, digits, that are the same for all the keys, are skipped
+void RadixSort(std::vector<uint64_t> &keys) {
+  constexpr size_t kDigitBits = 16;
+  constexpr size_t kDigits = 1 << kDigitBits;
+  std::vector<uint64_t> buffer(keys.size());
+  std::vector<size_t> counts(kDigits);
+
+  for (size_t shift = 0; shift < 64; shift += kDigitBits) {
+    std::fill(counts.begin(), counts.end(), 0);
+
+    for (uint64_t key : keys)
+      ++counts[(key >> shift) & (kDigits - 1)];
+
+    if (counts[(keys.front() >> shift) & (kDigits - 1)] == keys.size())
+      continue;
+
+    size_t position = 0;
+
+    for (size_t &count : counts) {
+      size_t digit_count = count;
+      count = position;
+      position += digit_count;
+    }
+
+    for (uint64_t key : keys)
+      buffer[counts[(key >> shift) & (kDigits - 1)]++] = key;
+
+    keys.swap(buffer);
+  }
+}
+
+void SortByXY(std::vector<Vector> &points) {
+  // Counting passes don't pay off on small inputs
+  constexpr size_t kRadixThreshold = 1 << 12;
+
+  if (points.size() < kRadixThreshold || !FitsInt32(points)) {
+    std::sort(points.begin(), points.end(), [](const Vector &left, const Vector &right) {
+      return left.x < right.x || (left.x == right.x && left.y < right.y);
+    });
+    return;
+  }
+
+  std::vector<uint64_t> keys(points.size());
+  std::transform(points.begin(), points.end(), keys.begin(), PackPoint);
+  RadixSort(keys);
+  std::transform(keys.begin(), keys.end(), points.begin(), UnpackPoint);
+}
+
+// Andrew's monotone chain: lower hull left to right, then upper hull right to left.
+// Sorts points in place instead of copying them
+std::vector<Vector> BuildConvexHullMonotone(std::vector<Vector> &points) {
+  if (points.empty())
+    return {};
+
+  SortByXY(points);
+  std::vector<Vector> hull;
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (i > 0 && points[i] == points[i - 1])
+      continue;
+
+    while (hull.size() >= 2 && (hull.back() - hull[hull.size() - 2]).Orient(points[i] - hull.back()) <= 0)
+      hull.pop_back();
+
+    hull.push_back(points[i]);
+  }
+
+  size_t lower_size = hull.size();
+
+  for (size_t i = points.size() - 1; i-- > 0;) {
+    if (points[i] == points[i + 1])
+      continue;
+
+    while (hull.size() > lower_size
+        && (hull.back() - hull[hull.size() - 2]).Orient(points[i] - hull.back()) <= 0)
+      hull.pop_back();
+
+    hull.push_back(points[i]);
+  }
+
+  // The first point is added by both chains
+  if (hull.size() > 1)
+    hull.pop_back();
+
+  return hull;
+}
+
+// Runs body(from, to) over threads_count contiguous chunks of [0, size) in parallel
+template<typename Body>
+void ParallelChunks(size_t size, size_t threads_count, Body body) {
+  std::vector<std::thread> threads;
+  size_t chunk = (size + threads_count - 1) / threads_count;
+
+  for (size_t from = 0; from < size; from += chunk)
+    threads.emplace_back(body, from, std::min(from + chunk, size));
+
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+// Outward normals of the Akl-Toussaint octagon in counter clockwise order
+constexpr std::array<Vector, 8> kOctagonDirections{
+    Vector{1, 0}, Vector{1, 1}, Vector{0, 1}, Vector{-1, 1},
+    Vector{-1, 0}, Vector{-1, -1}, Vector{0, -1}, Vector{1, -1}
+};
+
+struct OctagonExtremes {
+  void Add(const Vector &p) {
+    for (size_t i = 0; i < kOctagonDirections.size(); ++i)
+      if (kOctagonDirections[i].Dot(p) > kOctagonDirections[i].Dot(points[i]))
+        points[i] = p;
+  }
+
+  std::array<Vector, 8> points;
+};
+
+// A point strictly to the left of every edge lies strictly inside the hull of the octagon's vertices,
+// even if the octagon degenerates, so it can't be a vertex of the whole hull
+bool StrictlyInside(const Vector &p, const std::vector<Vector> &octagon) {
+  for (size_t i = 0; i < octagon.size(); ++i) {
+    const Vector &next = octagon[(i + 1) % octagon.size()];
+
+    if ((next - octagon[i]).Orient(p - octagon[i]) <= 0)
+      return false;
+  }
+
+  return true;
+}
+
+// Akl-Toussaint filtering, partial hulls and their merge, each of the first two stages in parallel.
+// On uniform inputs almost everything is thrown away by the filter, so the cost is about a linear scan
+std::vector<Vector> BuildConvexHullParallel(const std::vector<Vector> &points, size_t threads_count) {
+  if (points.empty())
+    return {};
+
+  threads_count = std::max<size_t>(1, std::min(threads_count, points.size()));
+  size_t chunk = (points.size() + threads_count - 1) / threads_count;
+  std::vector<OctagonExtremes> extremes((points.size() + chunk - 1) / chunk);
+
+  ParallelChunks(points.size(), threads_count, [&](size_t from, size_t to) {
+    OctagonExtremes &local = extremes[from / chunk];
+    local.points.fill(points[from]);
+
+    for (size_t i = from; i < to; ++i)
+      local.Add(points[i]);
+  });
+
+  OctagonExtremes all = extremes.front();
+
+  for (const OctagonExtremes &local : extremes)
+    for (const Vector &p : local.points)
+      all.Add(p);
+
+  std::vector<Vector> octagon;
+
+  for (const Vector &p : all.points)
+    if (octagon.empty() || !(p == octagon.back()))
+      octagon.push_back(p);
+
+  while (octagon.size() > 1 && octagon.back() == octagon.front())
+    octagon.pop_back();
+
+  std::vector<std::vector<Vector>> partial_hulls(extremes.size());
+
+  ParallelChunks(points.size(), threads_count, [&](size_t from, size_t to) {
+    std::vector<Vector> &survivors = partial_hulls[from / chunk];
+
+    for (size_t i = from; i < to; ++i)
+      if (!StrictlyInside(points[i], octagon))
+        survivors.push_back(points[i]);
+
+    survivors = BuildConvexHullMonotone(survivors);
+  });
+
+  std::vector<Vector> merged;
+
+  for (const std::vector<Vector> &hull : partial_hulls)
+    merged.insert(merged.end(), hull.begin(), hull.end());
+
+  return BuildConvexHullMonotone(merged);
+}
+
 double PolygonLength(const std::vector<Vector> &points) {
   double length = 0.0;
 
@@ -101,16 +398,128 @@ double PolygonLength(const std::vector<Vector> &points) {
   return length;
 }
 
-int main() {
-  int n;
-  std::cin >> n;
+// Upper part of a hull, that grows with insertions: for every x only the highest point is kept
+// and turns are strictly clockwise. Every point is inserted and erased at most once,
+// so the insertion is amortized O(log n). The length is kept up to date along the way
+class HullChain {
+ public:
+  // Returns whether p became a vertex
+  bool Insert(const Vector &p);
+
+  bool Empty() const { return points_.empty(); }
+  double Length() const { return length_; }
+  Vector Leftmost() const { return {points_.begin()->first, points_.begin()->second}; }
+  Vector Rightmost() const { return {points_.rbegin()->first, points_.rbegin()->second}; }
+
+ private:
+  using Iterator = std::map<Coordinate, Coordinate>::iterator;
+
+  static Vector At(Iterator it) { return {it->first, it->second}; }
+  static double Dist(Iterator left, Iterator right) { return (At(right) - At(left)).Dist(); }
+  // Whether the middle point can stay in the chain between left and right
+  static bool IsAbove(Iterator left, Iterator middle, Iterator right) {
+    return (At(right) - At(left)).Orient(At(middle) - At(left)) > 0;
+  }
+
+  void Erase(Iterator it);
+
+  std::map<Coordinate, Coordinate> points_;
+  double length_ = 0.0;
+};
+
+void HullChain::Erase(Iterator it) {
+  Iterator next = std::next(it);
+
+  if (it != points_.begin())
+    length_ -= Dist(std::prev(it), it);
+
+  if (next != points_.end())
+    length_ -= Dist(it, next);
+
+  if (it != points_.begin() && next != points_.end())
+    length_ += Dist(std::prev(it), next);
+
+  points_.erase(it);
+}
+
+bool HullChain::Insert(const Vector &p) {
+  Iterator next = points_.lower_bound(p.x);
+
+  if (next != points_.end() && next->first == p.x) {
+    if (next->second >= p.y)
+      return false;
+
+    Erase(next);
+    next = points_.lower_bound(p.x);
+  }
+
+  if (next != points_.end() && next != points_.begin()) {
+    Iterator prev = std::prev(next);
+
+    if ((At(next) - At(prev)).Orient(p - At(prev)) <= 0)
+      return false;
+
+    length_ -= Dist(prev, next);
+  }
+
+  Iterator it = points_.emplace(p.x, p.y).first;
+
+  if (it != points_.begin())
+    length_ += Dist(std::prev(it), it);
+
+  if (std::next(it) != points_.end())
+    length_ += Dist(it, std::next(it));
+
+  while (std::next(it) != points_.end() && std::next(it, 2) != points_.end()
+      && !IsAbove(it, std::next(it), std::next(it, 2)))
+    Erase(std::next(it));
+
+  while (it != points_.begin() && std::prev(it) != points_.begin()
+      && !IsAbove(std::prev(it, 2), std::prev(it), it))
+    Erase(std::prev(it));
+
+  return true;
+}
+
+// Convex hull of a stream of points as two chains, the lower one is kept upside down
+class DynamicConvexHull {
+ public:
+  void Insert(const Vector &p) {
+    upper_.Insert(p);
+    lower_.Insert({p.x, -p.y});
+  }
+
+  // Only the vertices of the batch's own hull can become vertices of the whole hull
+  void Insert(std::vector<Vector> points) {
+    for (const Vector &p : BuildConvexHullMonotone(points))
+      Insert(p);
+  }
+
+  double Perimeter() const {
+    if (upper_.Empty())
+      return 0.0;
+
+    // Vertical edges at the ends, if there are several points with the lowest or the highest x
+    return upper_.Length() + lower_.Length()
+        + (upper_.Leftmost().y + lower_.Leftmost().y) + (upper_.Rightmost().y + lower_.Rightmost().y);
+  }
+
+ private:
+  HullChain upper_;
+  HullChain lower_;
+};
+
+// With --binary the points are read as a block of ReadBinaryPoints
+int main(int argc, char **argv) {
+  InputReader reader(stdin);
   std::vector<Vector> points;
 
-  for (int i = 0; i < n; ++i) {
-    Coordinate x, y;
-    std::cin >> x >> y;
-    points.push_back({x, y});
+  if (argc > 1 && std::string(argv[1]) == "--binary") {
+    points = ReadBinaryPoints(reader);
+  } else {
+    size_t n = reader.ReadInteger<size_t>();
+    points = ReadPoints(reader, n);
   }
 
-  std::cout << std::setprecision(10) << PolygonLength(BuildConvexHull(points)) << '\n';
+  std::cout << std::setprecision(10) << PolygonLength(BuildConvexHullMonotone(points)) << '\n';
 }
@@ -3,10 +3,18 @@
 //
 #include <cassert>
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
 #include <vector>
 #include <algorithm>
-#include <unordered_set>
-#include <set>
+#include <unordered_map>
+#include <array>
+#include <optional>
+#include <random>
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <thread>
 
 using Coordinate = int;
 
@@ -16,205 +24,718 @@ struct Vector {
   Coordinate z;
   int id = -1;
 
-  Vector Cross(const Vector &other) const {
-    return {y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x};
+  bool operator==(const Vector &other) const {
+    return x == other.x && y == other.y && z == other.z;
   }
-
-  Coordinate Dot(const Vector &other) const {
-    return x * other.x + y * other.y + z * other.z;
+  bool operator!=(const Vector &other) const {
+    return !(*this == other);
   }
+};
 
-  Coordinate SqrDist() const {
-    return Dot(*this);
+// Only the ids of the vertices, the lowest one first
+struct Face {
+  /*
+   * p3
+   * |  \
+   * |    \
+   * |      \
+   * p1 ---- p2
+   *
+   * p1 -> p2 -> p3
+   *
+   */
+  Face(const Vector &p1, const Vector &p2, const Vector &p3) {
+    if (p1.id < p2.id && p1.id < p3.id) {
+      this->p1 = p1.id;
+      this->p2 = p2.id;
+      this->p3 = p3.id;
+    } else if (p2.id < p3.id) {
+      this->p1 = p2.id;
+      this->p2 = p3.id;
+      this->p3 = p1.id;
+    } else {
+      this->p1 = p3.id;
+      this->p2 = p1.id;
+      this->p3 = p2.id;
+    }
   }
 
-  // if this and other are collinear, then this tells whether or not they have the same direction
-  // if any vector is zero, direction is undefined
-  bool SameDir(const Vector &other) const {
-    return Dot(other) > 0;
-  }
+  int p1;
+  int p2;
+  int p3;
 
-  bool operator==(const Vector &other) const {
-    return x == other.x && y == other.y && z == other.z;
-  }
-  bool operator!=(const Vector &other) const {
-    return !(*this == other);
+  bool operator<(const Face &other) const {
+    return p1 < other.p1 || (p1 == other.p1 && (p2 < other.p2 || (p2 == other.p2 && p3 < other.p3)));
   }
 };
 
-Vector operator-(const Vector &left, const Vector &right) {
-  return {left.x - right.x, left.y - right.y, left.z - right.z};
+std::ostream &operator<<(std::ostream &out, const Vector &vector) {
+  out << vector.id;
+  return out;
 }
 
-Vector operator+(const Vector &left, const Vector &right) {
-  return {left.x + right.x, left.y + right.y, left.z + right.z};
+std::ostream &operator<<(std::ostream &out, const Face &face) {
+  out << "3 " << face.p1 << " " << face.p2 << " " << face.p3;
+  return out;
 }
 
-struct Segment {
-  Vector start;
-  Vector end;
+// Parses integers by hand from big blocks of the input, which is a lot faster than std::cin
+class InputReader {
+ public:
+  explicit InputReader(std::FILE *in) : in_(in) {}
+
+  template<typename Integer>
+  Integer ReadInteger() {
+    int c = SkipSpaces();
+    bool negative = c == '-';
+
+    if (negative)
+      c = NextChar();
+
+    Integer value = 0;
 
-  Vector Dir() const { return end - start; }
+    // Accumulated with the sign, so that the minimum of a signed type doesn't overflow
+    for (; '0' <= c && c <= '9'; c = NextChar())
+      value = negative ? value * 10 - (c - '0') : value * 10 + (c - '0');
 
-  bool operator==(const Segment &other) const {
-    return start == other.start && end == other.end;
+    return value;
   }
 
-  bool operator!=(const Segment &other) const {
-    return !(*this == other);
+  // Fixed width little-endian integer, the binary input is made of int64 only
+  int64_t ReadBinaryInteger() {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); ++i)
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(NextChar())) << (8 * i);
+
+    return static_cast<int64_t>(value);
   }
-};
 
-namespace std {
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  int NextChar() {
+    if (position_ == size_) {
+      size_ = std::fread(buffer_, 1, kBufferSize, in_);
+      position_ = 0;
 
-template<>
-struct hash<Vector> {
-  size_t operator()(const Vector &vector) const {
-    // just some random prime
-    return static_cast<size_t>(vector.x) * 199933 + static_cast<size_t>(vector.y);
+      if (size_ == 0)
+        return EOF;
+    }
+
+    return buffer_[position_++];
   }
-};
 
-template<>
-struct hash<Segment> {
-  size_t operator()(const Segment &segment) const {
-    // same
-    return hash<Vector>()(segment.start) * 37 + hash<Vector>()(segment.end);
+  int SkipSpaces() {
+    int c = NextChar();
+
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+      c = NextChar();
+
+    return c;
   }
+
+  std::FILE *in_;
+  char buffer_[kBufferSize];
+  size_t position_ = 0;
+  size_t size_ = 0;
 };
+
+// Text: "x y z" for every point, ids are the indices
+std::vector<Vector> ReadPoints(InputReader &reader, size_t n) {
+  std::vector<Vector> points(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    points[i].x = reader.ReadInteger<Coordinate>();
+    points[i].y = reader.ReadInteger<Coordinate>();
+    points[i].z = reader.ReadInteger<Coordinate>();
+    points[i].id = i;
+  }
+
+  return points;
 }
 
-struct Face {
-  /*
-   * p3
-   * |  \
-   * |    \
-   * |      \
-   * p1 ---- p2
-   *
-   * p1 -> p2 -> p3
-   *
-   */
-  Face(Vector p1, Vector p2, Vector p3) {
-    Vector lowest = std::min({p1, p2, p3}, [](const Vector &left, const Vector &right) -> bool {
-      return left.id < right.id;
-    });
+// Binary: u64 count, then little-endian int64 x, y and z for every point, ids are the indices
+std::vector<Vector> ReadBinaryPoints(InputReader &reader) {
+  std::vector<Vector> points(reader.ReadBinaryInteger());
 
-    this->p1 = lowest;
+  for (size_t i = 0; i < points.size(); ++i) {
+    points[i].x = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    points[i].y = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    points[i].z = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    points[i].id = i;
+  }
 
-    if (lowest == p1) {
-      this->p2 = p2;
-      this->p3 = p3;
-    } else if (lowest == p2) {
-      this->p2 = p3;
-      this->p3 = p1;
-    } else {
-      this->p2 = p1;
-      this->p3 = p2;
+  return points;
+}
+
+// Index based surface of a hull. Half-edge 3 * f + i of the face f goes from vertices[i]
+// to vertices[(i + 1) % 3], half-edges are found by the packed pair of their vertex ids
+class HalfEdgeMesh {
+ public:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  uint32_t FindHalfEdge(uint32_t from, uint32_t to) const {
+    auto it = half_edges_.find(Key(from, to));
+    return it == half_edges_.end() ? kNone : it->second;
+  }
+
+  // Links the new half-edges with their twins, that are already on the surface
+  uint32_t AddFace(uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t face = faces_.size();
+    faces_.push_back({a, b, c});
+
+    for (uint32_t i = 0; i < 3; ++i) {
+      uint32_t from = faces_[face][i];
+      uint32_t to = faces_[face][(i + 1) % 3];
+      uint32_t twin = FindHalfEdge(to, from);
+      half_edges_[Key(from, to)] = 3 * face + i;
+      twins_.push_back(twin);
+
+      if (twin != kNone)
+        twins_[twin] = 3 * face + i;
     }
+
+    return face;
   }
 
-  Vector p1;
-  Vector p2;
-  Vector p3;
+  size_t FaceCount() const { return faces_.size(); }
+  const std::array<uint32_t, 3> &Vertices(uint32_t face) const { return faces_[face]; }
+  // kNone while the other side is not built
+  uint32_t Twin(uint32_t half_edge) const { return twins_[half_edge]; }
 
-  bool operator<(const Face &other) const {
-    return p1.id < other.p1.id || (p1.id == other.p1.id
-        && (p2.id < other.p2.id || (p2.id == other.p2.id && p3.id < other.p3.id)));
+ private:
+  static uint64_t Key(uint32_t from, uint32_t to) {
+    return static_cast<uint64_t>(from) << 32 | to;
   }
+
+  std::vector<std::array<uint32_t, 3>> faces_;
+  std::vector<uint32_t> twins_;
+  std::unordered_map<uint64_t, uint32_t> half_edges_;
 };
 
-std::ostream &operator<<(std::ostream &out, const Vector &vector) {
-  out << vector.id;
-  return out;
+// Sign of six times the oriented volume of the tetrahedron, > 0 if d is on the outer side of the
+// counter clockwise (looking from outside) face a, b, c. While the differences stay below 2^20
+// the triple product fits in 64 bits, wider ones need __int128
+int Orient3D(const Vector &a, const Vector &b, const Vector &c, const Vector &d) {
+  int64_t ux = int64_t(b.x) - a.x, uy = int64_t(b.y) - a.y, uz = int64_t(b.z) - a.z;
+  int64_t vx = int64_t(c.x) - a.x, vy = int64_t(c.y) - a.y, vz = int64_t(c.z) - a.z;
+  int64_t wx = int64_t(d.x) - a.x, wy = int64_t(d.y) - a.y, wz = int64_t(d.z) - a.z;
+  int64_t span = 0;
+
+  for (int64_t value : {ux, uy, uz, vx, vy, vz, wx, wy, wz})
+    span = std::max(span, value < 0 ? -value : value);
+
+  if (span < (int64_t(1) << 20)) {
+    int64_t volume = (uy * vz - uz * vy) * wx + (uz * vx - ux * vz) * wy + (ux * vy - uy * vx) * wz;
+    return (volume > 0) - (volume < 0);
+  }
+
+  __int128 volume = (static_cast<__int128>(uy) * vz - static_cast<__int128>(uz) * vy) * wx
+                    + (static_cast<__int128>(uz) * vx - static_cast<__int128>(ux) * vz) * wy
+                    + (static_cast<__int128>(ux) * vy - static_cast<__int128>(uy) * vx) * wz;
+  return (volume > 0) - (volume < 0);
 }
 
-std::ostream &operator<<(std::ostream &out, const Face &face) {
-  out << "3 " << face.p1 << " " << face.p2 << " " << face.p3;
-  return out;
+bool Collinear(const Vector &a, const Vector &b, const Vector &c) {
+  __int128 ux = int64_t(b.x) - a.x, uy = int64_t(b.y) - a.y, uz = int64_t(b.z) - a.z;
+  __int128 vx = int64_t(c.x) - a.x, vy = int64_t(c.y) - a.y, vz = int64_t(c.z) - a.z;
+  return uy * vz == uz * vy && uz * vx == ux * vz && ux * vy == uy * vx;
 }
 
-Vector FoldPoint(const Segment &edge, const std::vector<Vector> &points) {
-  Vector best = edge.start;
+// Index of the point, that makes the face start -> end -> point with all other points behind it
+uint32_t FoldPoint(const Vector &start, const Vector &end, const std::vector<Vector> &points) {
+  uint32_t best = HalfEdgeMesh::kNone;
+
+  for (uint32_t i = 0; i < points.size(); ++i) {
+    const Vector &p = points[i];
 
-  for (Vector p : points) {
-    if (p == edge.start || p == edge.end)
+    if (p == start || p == end)
       continue;
 
-    if (best == edge.start) {
-      best = p;
+    if (best == HalfEdgeMesh::kNone) {
+      best = i;
       continue;
     }
 
-    if (best != p && edge.Dir().SameDir((best - edge.start).Cross(p - edge.start)))
-      best = p;
+    if (points[best] != p && Orient3D(start, points[best], p, end) > 0)
+      best = i;
   }
 
   return best;
 }
 
-Segment FindLowestEdge(const std::vector<Vector> &points) {
-  Vector lowest = points.front();
-  for (Vector p : points)
-    if (p.z < lowest.z)
-      lowest = p;
+std::pair<uint32_t, uint32_t> FindLowestEdge(const std::vector<Vector> &points) {
+  uint32_t lowest = 0;
+  for (uint32_t i = 0; i < points.size(); ++i)
+    if (points[i].z < points[lowest].z)
+      lowest = i;
 
-  for (Vector p : points)
-    if (p != lowest && p.z == lowest.z)
-      return {lowest, p};
+  for (uint32_t i = 0; i < points.size(); ++i)
+    if (points[i] != points[lowest] && points[i].z == points[lowest].z)
+      return {lowest, i};
 
-  Vector towards_x{lowest.x + 1, lowest.y, lowest.z};
+  const Vector &p = points[lowest];
+  Vector towards_x{p.x + 1, p.y, p.z};
 
-  return {lowest, FoldPoint({lowest, towards_x}, points)};
+  return {lowest, FoldPoint(p, towards_x, points)};
 }
 
-std::set<Face> BuildConvexHull(const std::vector<Vector> &points) {
-  std::vector<Segment> edges_left{FindLowestEdge(points)};
-  std::unordered_set<Segment> used_edges;
-  std::set<Face> faces;
+// Gift wrapping, every face is wrapped over a half-edge, whose twin is not on the surface yet.
+// Less than three distinct points have no faces
+std::vector<Face> BuildConvexHull(const std::vector<Vector> &points) {
+  if (points.empty())
+    return {};
+
+  std::vector<std::pair<uint32_t, uint32_t>> edges_left{FindLowestEdge(points)};
+  HalfEdgeMesh mesh;
+
+  if (edges_left.back().second == HalfEdgeMesh::kNone)
+    return {};
 
   while (!edges_left.empty()) {
-    Segment edge = edges_left.back();
+    auto [start, end] = edges_left.back();
     edges_left.pop_back();
 
-    if (used_edges.find(edge) != used_edges.end())
+    if (mesh.FindHalfEdge(start, end) != HalfEdgeMesh::kNone)
       continue;
 
-    used_edges.insert(edge);
+    uint32_t folding_point = FoldPoint(points[start], points[end], points);
 
-    Vector folding_point = FoldPoint(edge, points);
-    Face face(edge.start, edge.end, folding_point);
+    if (folding_point == HalfEdgeMesh::kNone)
+      return {};
 
-    if (faces.insert(face).second) {
-      edges_left.push_back({edge.start, folding_point});
-      edges_left.push_back({folding_point, edge.end});
-    }
+    mesh.AddFace(start, end, folding_point);
+    edges_left.emplace_back(start, folding_point);
+    edges_left.emplace_back(folding_point, end);
   }
 
+  std::vector<Face> faces;
+  faces.reserve(mesh.FaceCount());
+
+  for (uint32_t f = 0; f < mesh.FaceCount(); ++f) {
+    const std::array<uint32_t, 3> &v = mesh.Vertices(f);
+    faces.emplace_back(points[v[0]], points[v[1]], points[v[2]]);
+  }
+
+  std::sort(faces.begin(), faces.end());
   return faces;
 }
 
-int main() {
-  int m;
-  std::cin >> m;
+// Randomized incremental construction with a conflict graph over a half-edge mesh.
+// Half-edge 3 * f + i goes from vertices[i] to vertices[(i + 1) % 3] of the face f.
+// Points are renumbered in the order of insertion, so conflict lists are kept sorted,
+// already added points are always their prefix and two lists are joined with a merge
+class IncrementalHull {
+ public:
+  explicit IncrementalHull(const std::vector<Vector> &points);
+
+  // false if all the points are coplanar
+  bool Build();
+  std::vector<Face> Faces() const;
+  // Points, that are corners of the hull
+  std::vector<Vector> Vertices() const;
+
+ private:
+  struct HullFace {
+    std::array<uint32_t, 3> vertices;
+    std::array<uint32_t, 3> twins;
+    // Outer normal and its dot product with the vertices, wide enough for any int coordinates
+    std::array<__int128, 3> normal;
+    __int128 offset;
+    bool alive = true;
+    // points, that see the face, in the order of insertion
+    std::vector<uint32_t> conflicts;
+  };
+
+  bool Sees(uint32_t point, uint32_t face) const {
+    const HullFace &f = faces_[face];
+    const Vector &p = points_[point];
+    return f.normal[0] * p.x + f.normal[1] * p.y + f.normal[2] * p.z > f.offset;
+  }
+
+  uint32_t AddFace(uint32_t a, uint32_t b, uint32_t c);
+  void AddConflict(uint32_t point, uint32_t face);
+  std::optional<std::array<uint32_t, 4>> FindTetrahedron() const;
+  void AddPoint(uint32_t point);
+
+  // Dead face, that points, that see nothing, refer to
+  static constexpr uint32_t kInside = 0;
+
+  std::vector<Vector> points_;
+  std::vector<HullFace> faces_;
+  // Some face, that the point sees. If the point is still outside of the hull, but this face is dead,
+  // the point sees a face, that replaced it, and was moved to it, so a dead face means the point is inside
+  std::vector<uint32_t> conflict_face_;
+  // stamp of the last point, that saw the face
+  std::vector<uint32_t> visible_stamp_;
+  // new face, whose horizon edge starts at the vertex
+  std::vector<uint32_t> new_face_from_;
+};
+
+// Bits of a 21 bit number moved to every third position
+uint64_t SpreadBits(uint64_t value) {
+  value &= 0x1fffff;
+  value = (value | value << 32) & 0x1f00000000ffffULL;
+  value = (value | value << 16) & 0x1f0000ff0000ffULL;
+  value = (value | value << 8) & 0x100f00f00f00f00fULL;
+  value = (value | value << 4) & 0x10c30c30c30c30c3ULL;
+  value = (value | value << 2) & 0x1249249249249249ULL;
+  return value;
+}
+
+// Position on the Z-order curve by the top 21 bits of the coordinates
+uint64_t MortonKey(const Vector &p) {
+  auto top = [](Coordinate value) { return (static_cast<uint64_t>(value) + (uint64_t(1) << 31)) >> 11; };
+  return SpreadBits(top(p.x)) << 2 | SpreadBits(top(p.y)) << 1 | SpreadBits(top(p.z));
+}
+
+// Biased randomized insertion order: the points are shuffled, then every half of the order
+// (the last n / 2, the n / 4 before them and so on) is sorted along the Z-order curve.
+// The expectation stays O(n log n), but the points of a conflict list get close ids,
+// the merge is bound by the memory reads of the points and this makes them local
+IncrementalHull::IncrementalHull(const std::vector<Vector> &points) {
+  std::vector<std::pair<uint64_t, Vector>> keyed;
+  keyed.reserve(points.size());
+
+  for (const Vector &p : points)
+    keyed.emplace_back(MortonKey(p), p);
+
+  std::shuffle(keyed.begin(), keyed.end(), std::mt19937(points.size()));
+  auto by_key = [](const auto &left, const auto &right) { return left.first < right.first; };
+
+  for (size_t end = keyed.size(); end > 64; end /= 2)
+    std::sort(keyed.begin() + end / 2, keyed.begin() + end, by_key);
+
+  points_.reserve(keyed.size());
+
+  for (const auto &[key, p] : keyed)
+    points_.push_back(p);
+}
+
+uint32_t IncrementalHull::AddFace(uint32_t a, uint32_t b, uint32_t c) {
+  const Vector &p = points_[a];
+  __int128 ux = points_[b].x - static_cast<__int128>(p.x);
+  __int128 uy = points_[b].y - static_cast<__int128>(p.y);
+  __int128 uz = points_[b].z - static_cast<__int128>(p.z);
+  __int128 vx = points_[c].x - static_cast<__int128>(p.x);
+  __int128 vy = points_[c].y - static_cast<__int128>(p.y);
+  __int128 vz = points_[c].z - static_cast<__int128>(p.z);
+  std::array<__int128, 3> normal{uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx};
+  __int128 offset = normal[0] * p.x + normal[1] * p.y + normal[2] * p.z;
+  faces_.push_back({{a, b, c}, {0, 0, 0}, normal, offset, true, {}});
+  visible_stamp_.push_back(0);
+  return faces_.size() - 1;
+}
+
+void IncrementalHull::AddConflict(uint32_t point, uint32_t face) {
+  faces_[face].conflicts.push_back(point);
+  conflict_face_[point] = face;
+}
+
+std::optional<std::array<uint32_t, 4>> IncrementalHull::FindTetrahedron() const {
+  std::array<uint32_t, 4> result{0, 0, 0, 0};
+  size_t n = points_.size();
+  size_t i = 1;
+
+  if (n < 4)
+    return std::nullopt;
+
+  for (; i < n && points_[i] == points_[0]; ++i) {}
+
+  if (i == n)
+    return std::nullopt;
+
+  result[1] = i;
+
+  for (i = 1; i < n && Collinear(points_[0], points_[result[1]], points_[i]); ++i) {}
+
+  if (i == n)
+    return std::nullopt;
+
+  result[2] = i;
+
+  for (i = 1; i < n && Orient3D(points_[0], points_[result[1]], points_[result[2]], points_[i]) == 0; ++i) {}
+
+  if (i == n)
+    return std::nullopt;
+
+  result[3] = i;
+  return result;
+}
+
+bool IncrementalHull::Build() {
+  auto tetrahedron = FindTetrahedron();
+
+  if (!tetrahedron)
+    return false;
+
+  // The tetrahedron goes first in the order of insertion
+  for (uint32_t i = 0; i < 4; ++i)
+    std::swap(points_[i], points_[(*tetrahedron)[i]]);
+
+  uint32_t a = 0, b = 1, c = 2, d = 3;
+
+  if (Orient3D(points_[a], points_[b], points_[c], points_[d]) > 0)
+    std::swap(b, c);
+
+  AddFace(0, 0, 0);
+  faces_[kInside].alive = false;
+  // d is behind a, b, c, so all of these look outside
+  AddFace(a, b, c);
+  AddFace(a, d, b);
+  AddFace(b, d, c);
+  AddFace(c, d, a);
+
+  for (uint32_t f = 1; f <= 4; ++f)
+    for (uint32_t i = 0; i < 3; ++i)
+      for (uint32_t g = 1; g <= 4; ++g)
+        for (uint32_t j = 0; j < 3; ++j)
+          if (faces_[f].vertices[i] == faces_[g].vertices[(j + 1) % 3]
+              && faces_[f].vertices[(i + 1) % 3] == faces_[g].vertices[j])
+            faces_[f].twins[i] = 3 * g + j;
 
-  for (int test_id = 0; test_id < m; ++test_id) {
-    int n;
-    std::cin >> n;
+  size_t n = points_.size();
+  conflict_face_.assign(n, kInside);
+  new_face_from_.assign(n, 0);
 
-    std::vector<Vector> points;
+  for (uint32_t p = 4; p < n; ++p)
+    for (uint32_t f = 1; f <= 4; ++f)
+      if (Sees(p, f))
+        AddConflict(p, f);
 
-    for (int i = 0; i < n; ++i) {
-      Coordinate x, y, z;
-      std::cin >> x >> y >> z;
-      points.push_back({x, y, z, i});
+  for (uint32_t p = 4; p < n; ++p)
+    AddPoint(p);
+
+  return true;
+}
+
+void IncrementalHull::AddPoint(uint32_t point) {
+  uint32_t start = conflict_face_[point];
+
+  // Inside of the hull
+  if (!faces_[start].alive)
+    return;
+
+  // stamps start from 1, so that 0 means never
+  uint32_t stamp = point + 1;
+  // Visible faces are connected
+  std::vector<uint32_t> visible{start};
+  std::vector<uint32_t> horizon;
+  visible_stamp_[start] = stamp;
+
+  for (size_t i = 0; i < visible.size(); ++i)
+    for (uint32_t j = 0; j < 3; ++j) {
+      uint32_t neighbour = faces_[visible[i]].twins[j] / 3;
+
+      if (visible_stamp_[neighbour] == stamp)
+        continue;
+
+      if (Sees(point, neighbour)) {
+        visible_stamp_[neighbour] = stamp;
+        visible.push_back(neighbour);
+      }
     }
 
-    std::set<Face> hull = BuildConvexHull(points);
+  for (uint32_t f : visible)
+    for (uint32_t i = 0; i < 3; ++i)
+      if (visible_stamp_[faces_[f].twins[i] / 3] != stamp)
+        horizon.push_back(3 * f + i);
+
+  std::vector<uint32_t> new_faces;
+
+  for (uint32_t edge : horizon) {
+    uint32_t from = faces_[edge / 3].vertices[edge % 3];
+    uint32_t to = faces_[edge / 3].vertices[(edge % 3 + 1) % 3];
+    uint32_t face = AddFace(from, to, point);
+    uint32_t outer = faces_[edge / 3].twins[edge % 3];
+    faces_[face].twins[0] = outer;
+    faces_[outer / 3].twins[outer % 3] = 3 * face;
+    new_face_from_[from] = face;
+    new_faces.push_back(face);
+  }
 
-    std::cout << hull.size() << '\n';
+  for (uint32_t face : new_faces) {
+    // to -> point is the twin of point -> to of the next face on the horizon
+    uint32_t next = new_face_from_[faces_[face].vertices[1]];
+    faces_[face].twins[1] = 3 * next + 2;
+    faces_[next].twins[2] = 3 * face + 1;
+  }
 
-    for (Face f : hull)
-      std::cout << f << '\n';
+  // A point can see a new face only if it saw one of the two old faces around its horizon edge
+  for (size_t i = 0; i < horizon.size(); ++i) {
+    uint32_t face = new_faces[i];
+    const std::vector<uint32_t> &inner = faces_[horizon[i] / 3].conflicts;
+    const std::vector<uint32_t> &outer = faces_[faces_[face].twins[0] / 3].conflicts;
+    auto inner_it = std::upper_bound(inner.begin(), inner.end(), point);
+    auto outer_it = std::upper_bound(outer.begin(), outer.end(), point);
+    std::vector<uint32_t> conflicts;
+
+    while (inner_it != inner.end() || outer_it != outer.end()) {
+      uint32_t candidate;
+
+      if (inner_it != inner.end() && (outer_it == outer.end() || *inner_it <= *outer_it)) {
+        candidate = *inner_it++;
+
+        if (outer_it != outer.end() && *outer_it == candidate)
+          ++outer_it;
+      } else {
+        candidate = *outer_it++;
+      }
+
+      if (Sees(candidate, face)) {
+        conflicts.push_back(candidate);
+        conflict_face_[candidate] = face;
+      }
+    }
+
+    faces_[face].conflicts = std::move(conflicts);
+  }
+
+  for (uint32_t f : visible) {
+    faces_[f].alive = false;
+    faces_[f].conflicts.clear();
+    faces_[f].conflicts.shrink_to_fit();
   }
 }
+
+std::vector<Face> IncrementalHull::Faces() const {
+  std::vector<Face> result;
+
+  for (const HullFace &face : faces_)
+    if (face.alive)
+      result.emplace_back(points_[face.vertices[0]], points_[face.vertices[1]], points_[face.vertices[2]]);
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<Vector> IncrementalHull::Vertices() const {
+  std::vector<bool> is_vertex(points_.size(), false);
+
+  for (const HullFace &face : faces_)
+    if (face.alive)
+      for (uint32_t v : face.vertices)
+        is_vertex[v] = true;
+
+  std::vector<Vector> result;
+
+  for (size_t i = 0; i < points_.size(); ++i)
+    if (is_vertex[i])
+      result.push_back(points_[i]);
+
+  return result;
+}
+
+// Expected O(n log n), in the same order as BuildConvexHull gives.
+// Coplanar inputs are left to gift wrapping
+std::vector<Face> BuildConvexHullIncremental(const std::vector<Vector> &points) {
+  IncrementalHull hull(points);
+
+  if (!hull.Build())
+    return BuildConvexHull(points);
+
+  return hull.Faces();
+}
+
+// Splits the points into threads_count slabs along x and builds their hulls concurrently.
+// Only the vertices of the slab hulls can be the vertices of the whole hull, so the final
+// hull is built over their union, which is usually a small part of a big cloud
+std::vector<Face> BuildConvexHullParallel(std::vector<Vector> points, size_t threads_count) {
+  threads_count = std::max<size_t>(1, std::min(threads_count, points.size() / 4));
+
+  if (threads_count == 1)
+    return BuildConvexHullIncremental(points);
+
+  size_t chunk = (points.size() + threads_count - 1) / threads_count;
+  // Rounding the chunk up can leave the last slabs empty, they are not made at all
+  threads_count = (points.size() + chunk - 1) / chunk;
+  auto by_x = [](const Vector &left, const Vector &right) { return left.x < right.x; };
+
+  for (size_t from = chunk; from < points.size(); from += chunk)
+    std::nth_element(points.begin() + from - chunk, points.begin() + from, points.end(), by_x);
+
+  std::vector<std::vector<Vector>> vertices(threads_count);
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < threads_count; ++i)
+    threads.emplace_back([&, i]() {
+      std::vector<Vector> slab(points.begin() + i * chunk, points.begin() + std::min((i + 1) * chunk, points.size()));
+      IncrementalHull hull(slab);
+      // A flat slab has no corners to tell, all of it goes on
+      vertices[i] = hull.Build() ? hull.Vertices() : std::move(slab);
+    });
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  std::vector<Vector> candidates;
+
+  for (const std::vector<Vector> &part : vertices)
+    candidates.insert(candidates.end(), part.begin(), part.end());
+
+  return BuildConvexHullIncremental(candidates);
+}
+
+// The answer to one test as it is printed
+std::string FormatHull(const std::vector<Face> &hull) {
+  std::string out = std::to_string(hull.size()) + '\n';
+
+  for (const Face &f : hull) {
+    out += "3 ";
+    out += std::to_string(f.p1);
+    out += ' ';
+    out += std::to_string(f.p2);
+    out += ' ';
+    out += std::to_string(f.p3);
+    out += '\n';
+  }
+
+  return out;
+}
+
+// Answers in the order of the tests. Sizes of tests vary a lot, so the idle threads take
+// the biggest of the remaining tests from a shared counter, instead of getting fixed shares
+std::vector<std::string> SolveTests(const std::vector<std::vector<Vector>> &tests, size_t threads_count) {
+  std::vector<size_t> order(tests.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t left, size_t right) {
+    return tests[left].size() > tests[right].size();
+  });
+
+  std::vector<std::string> answers(tests.size());
+  std::atomic<size_t> next_test{0};
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < std::max<size_t>(1, std::min(threads_count, tests.size())); ++i)
+    threads.emplace_back([&]() {
+      for (size_t k = next_test++; k < order.size(); k = next_test++)
+        answers[order[k]] = FormatHull(BuildConvexHullIncremental(tests[order[k]]));
+    });
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  return answers;
+}
+
+// With --binary the input is a little-endian int64 number of tests, then a block of ReadBinaryPoints per test
+int main(int argc, char **argv) {
+  std::ios_base::sync_with_stdio(false);
+  InputReader reader(stdin);
+  bool binary = argc > 1 && std::string(argv[1]) == "--binary";
+  size_t m = binary ? reader.ReadBinaryInteger() : reader.ReadInteger<size_t>();
+  std::vector<std::vector<Vector>> tests(m);
+
+  for (size_t test_id = 0; test_id < m; ++test_id) {
+    if (binary) {
+      tests[test_id] = ReadBinaryPoints(reader);
+    } else {
+      size_t n = reader.ReadInteger<size_t>();
+      tests[test_id] = ReadPoints(reader, n);
+    }
+  }
+
+  for (const std::string &answer : SolveTests(tests, std::thread::hardware_concurrency()))
+    std::cout << answer;
+}
@@ -2,23 +2,55 @@
 // Created by egork on 10.11.2020.
 //
 #include <iostream>
+#include <cstdio>
+#include <cstdint>
 #include <iomanip>
 #include <vector>
+#include <string>
 #include <cmath>
+#include <utility>
+#include <queue>
 
 using Coordinate = long long;
 
+// Sign of a * b - c * d. Factors below 2^31 by absolute value are multiplied in 64 bits,
+// which can't overflow for them, the rest in __int128
+int ProductDifferenceSign(Coordinate a, Coordinate b, Coordinate c, Coordinate d) {
+  auto fits = [](Coordinate value) { return static_cast<uint64_t>(value) + (uint64_t(1) << 31) < (uint64_t(1) << 32); };
+
+  if (fits(a) && fits(b) && fits(c) && fits(d)) {
+    int64_t value = int64_t(a) * b - int64_t(c) * d;
+    return (value > 0) - (value < 0);
+  }
+
+  __int128 value = static_cast<__int128>(a) * b - static_cast<__int128>(c) * d;
+  return (value > 0) - (value < 0);
+}
+
 struct Vector {
   Coordinate x;
   Coordinate y;
 
-  Coordinate Cross(const Vector &other) const {
-    return x * other.y - y * other.x;
+  // Values go on to long double math, so they are just taken wide
+  __int128 Cross(const Vector &other) const {
+    return static_cast<__int128>(x) * other.y - static_cast<__int128>(y) * other.x;
+  }
+
+  __int128 Dot(const Vector &other) const {
+    return static_cast<__int128>(x) * other.x + static_cast<__int128>(y) * other.y;
   }
 
-  long double Angle() const {
-    long double atan2 = std::atan2(static_cast<long double>(y), static_cast<long double>(x));
-    return atan2 >= 0.0 ? atan2 : (atan2 + 2.0l * M_PIl);
+  int CrossSign(const Vector &other) const {
+    return ProductDifferenceSign(x, other.y, y, other.x);
+  }
+
+  long double Length() const {
+    return std::sqrt(static_cast<long double>(Dot(*this)));
+  }
+
+  // 0 for the polar angles in [0, pi), 1 for [pi, 2 pi)
+  int HalfPlane() const {
+    return y > 0 || (y == 0 && x > 0) ? 0 : 1;
   }
 
   Vector operator+(const Vector &other) const {
@@ -30,19 +62,106 @@ struct Vector {
   }
 };
 
-std::vector<Vector> ReadPolygon() {
-  size_t n;
-  std::cin >> n;
+// Parses integers by hand from big blocks of the input, which is a lot faster than std::cin
+class InputReader {
+ public:
+  explicit InputReader(std::FILE *in) : in_(in) {}
+
+  template<typename Integer>
+  Integer ReadInteger() {
+    int c = SkipSpaces();
+    bool negative = c == '-';
+
+    if (negative)
+      c = NextChar();
+
+    Integer value = 0;
+
+    // Accumulated with the sign, so that the minimum of a signed type doesn't overflow
+    for (; '0' <= c && c <= '9'; c = NextChar())
+      value = negative ? value * 10 - (c - '0') : value * 10 + (c - '0');
+
+    return value;
+  }
+
+  // Fixed width little-endian integer, the binary input is made of int64 only
+  int64_t ReadBinaryInteger() {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); ++i)
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(NextChar())) << (8 * i);
+
+    return static_cast<int64_t>(value);
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  int NextChar() {
+    if (position_ == size_) {
+      size_ = std::fread(buffer_, 1, kBufferSize, in_);
+      position_ = 0;
+
+      if (size_ == 0)
+        return EOF;
+    }
+
+    return buffer_[position_++];
+  }
+
+  int SkipSpaces() {
+    int c = NextChar();
+
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+      c = NextChar();
+
+    return c;
+  }
+
+  std::FILE *in_;
+  char buffer_[kBufferSize];
+  size_t position_ = 0;
+  size_t size_ = 0;
+};
+
+// Text: "x y" for every point
+std::vector<Vector> ReadPoints(InputReader &reader, size_t n) {
+  std::vector<Vector> points(n);
+
+  for (Vector &p : points) {
+    p.x = reader.ReadInteger<Coordinate>();
+    p.y = reader.ReadInteger<Coordinate>();
+  }
+
+  return points;
+}
 
-  std::vector<Vector> polygon(n);
+// Binary: u64 count, then little-endian int64 x and y for every point
+std::vector<Vector> ReadBinaryPoints(InputReader &reader) {
+  std::vector<Vector> points(reader.ReadBinaryInteger());
 
-  for (size_t i = 0; i < n; ++i) {
-    Coordinate x, y;
-    std::cin >> x >> y;
-    polygon[i] = {x, y};
+  for (Vector &p : points) {
+    p.x = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    p.y = static_cast<Coordinate>(reader.ReadBinaryInteger());
   }
 
-  return polygon;
+  return points;
+}
+
+std::vector<Vector> ReadPolygon(InputReader &reader) {
+  size_t n = reader.ReadInteger<size_t>();
+  return ReadPoints(reader, n);
+}
+
+// Exact comparison of the polar angles in [0, 2 pi), < 0 if left goes first, 0 if the directions are the same
+int CompareAngles(const Vector &left, const Vector &right) {
+  int left_half = left.HalfPlane();
+  int right_half = right.HalfPlane();
+
+  if (left_half != right_half)
+    return left_half - right_half;
+
+  return -left.CrossSign(right);
 }
 
 size_t BottomLeftPoint(const std::vector<Vector> &polygon) {
@@ -59,6 +178,7 @@ size_t BottomLeftPoint(const std::vector<Vector> &polygon) {
 std::vector<Vector> MinkovskiSum(const std::vector<Vector> &polygon1,
                                  const std::vector<Vector> &polygon2) {
   std::vector<Vector> result;
+  result.reserve(polygon1.size() + polygon2.size());
   size_t i = BottomLeftPoint(polygon1);
   size_t j = BottomLeftPoint(polygon2);
   size_t count1 = 0;
@@ -69,13 +189,12 @@ std::vector<Vector> MinkovskiSum(const std::vector<Vector> &polygon1,
     size_t i_next = (i + 1) % polygon1.size();
     size_t j_next = (j + 1) % polygon2.size();
 
-    long double angle_i = (polygon1[i_next] - polygon1[i]).Angle();
-    long double angle_j = (polygon2[j_next] - polygon2[j]).Angle();
+    int order = CompareAngles(polygon1[i_next] - polygon1[i], polygon2[j_next] - polygon2[j]);
 
-    if (angle_i < angle_j) {
+    if (order < 0) {
       i = i_next;
       ++count1;
-    } else if (angle_i > angle_j) {
+    } else if (order > 0) {
       j = j_next;
       ++count2;
     } else {
@@ -95,8 +214,230 @@ std::vector<Vector> MinkovskiSum(const std::vector<Vector> &polygon1,
   return result;
 }
 
+// Sum of all the polygons by a k-way merge of their edges, that are taken in the order of the
+// polar angles from a heap, O(N log k) for N vertices in total. Edges of the same direction are joined
+std::vector<Vector> MinkovskiSum(const std::vector<std::vector<Vector>> &polygons) {
+  struct Edge {
+    Vector dir;
+    size_t polygon;
+  };
+
+  auto later = [](const Edge &left, const Edge &right) { return CompareAngles(left.dir, right.dir) > 0; };
+  std::priority_queue<Edge, std::vector<Edge>, decltype(later)> edges(later);
+  std::vector<size_t> position(polygons.size());
+  Vector current{0, 0};
+  size_t total_size = 0;
+
+  for (size_t k = 0; k < polygons.size(); ++k) {
+    const std::vector<Vector> &polygon = polygons[k];
+
+    if (polygon.empty())
+      continue;
+
+    position[k] = BottomLeftPoint(polygon);
+    current = current + polygon[position[k]];
+    total_size += polygon.size();
+
+    if (polygon.size() > 1)
+      edges.push({polygon[(position[k] + 1) % polygon.size()] - polygon[position[k]], k});
+  }
+
+  std::vector<Vector> result;
+
+  if (total_size == 0)
+    return result;
+
+  result.reserve(total_size);
+  result.push_back(current);
+  // the last edge of each polygon leads back to its start
+  std::vector<size_t> edges_left(polygons.size());
+
+  for (size_t k = 0; k < polygons.size(); ++k)
+    edges_left[k] = polygons[k].size() > 1 ? polygons[k].size() - 1 : 0;
+
+  Vector last_dir{0, 0};
+
+  while (!edges.empty()) {
+    Edge edge = edges.top();
+    edges.pop();
+
+    current = current + edge.dir;
+
+    if (result.size() > 1 && CompareAngles(last_dir, edge.dir) == 0)
+      result.back() = current;
+    else
+      result.push_back(current);
+
+    last_dir = edge.dir;
+    const std::vector<Vector> &polygon = polygons[edge.polygon];
+    size_t &i = position[edge.polygon];
+    i = (i + 1) % polygon.size();
+
+    if (edges_left[edge.polygon] > 0) {
+      --edges_left[edge.polygon];
+      edges.push({polygon[(i + 1) % polygon.size()] - polygon[i], edge.polygon});
+    }
+  }
+
+  // The last edge closes the polygon, a sum of single points has no edges
+  if (result.size() > 1)
+    result.pop_back();
+
+  return result;
+}
+
+struct Collision {
+  bool intersect;
+  // between the closest points, 0 if the polygons intersect
+  long double distance;
+  // shortest shift, that takes the polygons apart, 0 if they don't intersect
+  long double penetration;
+};
+
+// Convex polygons, counter clockwise, that are tested against each other by the edges of
+// P - Q = P + (-Q): it contains the origin iff P and Q intersect, and its distance to
+// the origin is the distance between them. The difference is walked, but never stored
+class ConvexPolygonSet {
+ public:
+  size_t Add(const std::vector<Vector> &polygon);
+
+  Collision Collide(size_t first, size_t second) const;
+  std::vector<Collision> Collide(const std::vector<std::pair<size_t, size_t>> &pairs) const;
+
+ private:
+  struct Polygon {
+    // rotated to start at BottomLeftPoint, so the edges go in the order of their polar angles
+    std::vector<Vector> vertices;
+    // the top right vertex, that is the bottom left one of the reflected polygon
+    size_t top_right;
+  };
+
+  // visitor(a, b) for every edge a -> b of first - second, counter clockwise
+  template<typename Visitor>
+  void ForEachDifferenceEdge(const Polygon &first, const Polygon &second, Visitor visitor) const;
+
+  std::vector<Polygon> polygons_;
+};
+
+size_t ConvexPolygonSet::Add(const std::vector<Vector> &polygon) {
+  size_t start = BottomLeftPoint(polygon);
+  Polygon normalized;
+  normalized.vertices.reserve(polygon.size());
+
+  for (size_t i = 0; i < polygon.size(); ++i)
+    normalized.vertices.push_back(polygon[(start + i) % polygon.size()]);
+
+  normalized.top_right = 0;
+
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const Vector &p = normalized.vertices[i];
+    const Vector &best = normalized.vertices[normalized.top_right];
+
+    if (p.y > best.y || (p.y == best.y && p.x > best.x))
+      normalized.top_right = i;
+  }
+
+  polygons_.push_back(std::move(normalized));
+  return polygons_.size() - 1;
+}
+
+template<typename Visitor>
+void ConvexPolygonSet::ForEachDifferenceEdge(const Polygon &first, const Polygon &second, Visitor visitor) const {
+  const std::vector<Vector> &p = first.vertices;
+  const std::vector<Vector> &q = second.vertices;
+  size_t i = 0;
+  size_t j = second.top_right;
+  size_t count1 = 0;
+  size_t count2 = 0;
+  Vector current = p[i] - q[j];
+
+  // The same merge as in MinkovskiSum, -q[j] -> -q[j + 1] being the edges of -Q
+  while (count1 < p.size() || count2 < q.size()) {
+    size_t i_next = (i + 1) % p.size();
+    size_t j_next = (j + 1) % q.size();
+    int order;
+
+    if (count1 == p.size())
+      order = 1;
+    else if (count2 == q.size())
+      order = -1;
+    else
+      order = CompareAngles(p[i_next] - p[i], q[j] - q[j_next]);
+
+    if (order <= 0) {
+      i = i_next;
+      ++count1;
+    }
+
+    if (order >= 0) {
+      j = j_next;
+      ++count2;
+    }
+
+    Vector next = p[i] - q[j];
+    visitor(current, next);
+    current = next;
+  }
+}
+
+Collision ConvexPolygonSet::Collide(size_t first, size_t second) const {
+  bool inside = true;
+  // the origin is on the lines of all the edges, which happens only if the difference is a point or a segment
+  bool flat = true;
+  long double distance = INFINITY;
+  long double penetration = INFINITY;
+
+  ForEachDifferenceEdge(polygons_[first], polygons_[second], [&](const Vector &a, const Vector &b) {
+    Vector edge = b - a;
+
+    if (edge.x == 0 && edge.y == 0) {
+      distance = std::min(distance, a.Length());
+      return;
+    }
+
+    Vector to_origin{-a.x, -a.y};
+    __int128 side = edge.Cross(to_origin);
+    long double length = edge.Length();
+
+    if (side < 0)
+      inside = false;
+
+    if (side != 0)
+      flat = false;
+
+    penetration = std::min(penetration, side / length);
+
+    if (edge.Dot(to_origin) <= 0)
+      distance = std::min(distance, a.Length());
+    else if (edge.Dot(to_origin) >= edge.Dot(edge))
+      distance = std::min(distance, b.Length());
+    else
+      distance = std::min(distance, (side < 0 ? -side : side) / length);
+  });
+
+  // Then being on the left of every edge says nothing, the origin has to be on the difference itself.
+  // The distance is exactly 0 in that case: either side or an end of an edge is 0
+  if (flat)
+    return {distance == 0, distance, 0.0l};
+
+  if (inside)
+    return {true, 0.0l, penetration};
+
+  return {false, distance, 0.0l};
+}
+
+std::vector<Collision> ConvexPolygonSet::Collide(const std::vector<std::pair<size_t, size_t>> &pairs) const {
+  std::vector<Collision> result;
+  result.reserve(pairs.size());
+
+  for (const auto &[first, second] : pairs)
+    result.push_back(Collide(first, second));
+
+  return result;
+}
+
 long double PolygonArea(const std::vector<Vector> &polygon) {
-  Coordinate oriented_area = 0;
+  __int128 oriented_area = 0;
   Vector first = polygon.front();
 
   for (size_t i = 1; i < polygon.size() - 1; ++i)
@@ -105,9 +446,12 @@ long double PolygonArea(const std::vector<Vector> &polygon) {
   return oriented_area / 2.0l;
 }
 
-int main() {
-  std::vector<Vector> polygon1 = ReadPolygon();
-  std::vector<Vector> polygon2 = ReadPolygon();
+// With --binary each polygon is a block of ReadBinaryPoints
+int main(int argc, char **argv) {
+  InputReader reader(stdin);
+  bool binary = argc > 1 && std::string(argv[1]) == "--binary";
+  std::vector<Vector> polygon1 = binary ? ReadBinaryPoints(reader) : ReadPolygon(reader);
+  std::vector<Vector> polygon2 = binary ? ReadBinaryPoints(reader) : ReadPolygon(reader);
   std::vector<Vector> minkovski_sum = MinkovskiSum(polygon1, polygon2);
   std::cout << std::setprecision(6) << std::setiosflags(std::ios_base::fixed)
             << (PolygonArea(minkovski_sum) - PolygonArea(polygon1) - PolygonArea(polygon2)) / 2.0l
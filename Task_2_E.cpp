@@ -3,15 +3,36 @@
 //
 #include <algorithm>
 #include <iostream>
+#include <cstdio>
 #include <optional>
 #include <vector>
-#include <set>
+#include <string>
+#include <cstdint>
+#include <random>
+#include <queue>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include <thread>
 #include <utility>
 #include <tuple>
-#include <cassert>
 
 using Coordinate = long long;
 
+// Sign of a * b - c * d, exact for any coordinates. While all the factors are below 2^31
+// in absolute value the products fit in 64 bits, bigger ones are multiplied in __int128
+int ProductDifferenceSign(Coordinate a, Coordinate b, Coordinate c, Coordinate d) {
+  auto fits = [](Coordinate value) { return static_cast<uint64_t>(value) + (uint64_t(1) << 31) < (uint64_t(1) << 32); };
+
+  if (fits(a) && fits(b) && fits(c) && fits(d)) {
+    int64_t value = int64_t(a) * b - int64_t(c) * d;
+    return (value > 0) - (value < 0);
+  }
+
+  __int128 value = static_cast<__int128>(a) * b - static_cast<__int128>(c) * d;
+  return (value > 0) - (value < 0);
+}
+
 enum Orientation : int {
   CounterClockwise = -1,
   SameAngle = 0,
@@ -22,23 +43,8 @@ struct Vector {
   Coordinate x;
   Coordinate y;
 
-  Coordinate Dot(const Vector &other) const {
-    return x * other.x + y * other.y;
-  }
-
-  Coordinate Cross(const Vector &other) const {
-    return x * other.y - y * other.x;
-  }
-
   Orientation Orient(const Vector &other) const {
-    Coordinate prod = Cross(other);
-
-    if (prod > 0)
-      return Clockwise;
-    else if (prod < 0)
-      return CounterClockwise;
-    else
-      return SameAngle;
+    return static_cast<Orientation>(ProductDifferenceSign(x, other.y, y, other.x));
   }
 
   bool operator<(const Vector &other) const {
@@ -82,12 +88,13 @@ struct Segment {
   // if (this.y < target_y) then < 0
   // if (this.y = target_y) then = 0
   // if (this.y > target_y) then > 0
-  Coordinate CompareYAt(Coordinate x, Coordinate target_y) const {
+  int CompareYAt(Coordinate x, Coordinate target_y) const {
     // y = start.y + (x - start.x) / DiffX() * DiffY()
     // y < target_y   <=>   DiffX() * y < target_y * DiffX()
     //   =                              =
     //   >                              >
-    return (start.y * DiffX() + (x - start.x) * DiffY()) - target_y * DiffX();
+    // DiffX() * (y - target_y) = (start.y - target_y) * DiffX() - (start.x - x) * DiffY()
+    return ProductDifferenceSign(start.y - target_y, DiffX(), start.x - x, DiffY());
   }
 
   // Compare two segments by their Y coordinate at X position max{this->start.x, other.start.x}
@@ -99,9 +106,9 @@ struct Segment {
   // if (*this < other) then < 0
   // if (*this = other) then = 0
   // if (*this > other) then > 0
-  Coordinate CompareY(const Segment &other) const {
+  int CompareY(const Segment &other) const {
     if (DiffX() == 0 && other.DiffX() == 0)
-      return LowY() - other.LowY();
+      return (LowY() > other.LowY()) - (LowY() < other.LowY());
     else if (DiffX() == 0)
       return -other.CompareYAt(start.x, LowY());
     else if (other.DiffX() == 0)
@@ -141,7 +148,7 @@ struct Segment {
   }
 
   bool operator<(const Segment &other) const {
-    Coordinate y_comparison = CompareY(other);
+    int y_comparison = CompareY(other);
     return y_comparison < 0 || (y_comparison == 0
         && std::tie(start, end, id) < std::tie(other.start, other.end, other.id));
   }
@@ -155,6 +162,80 @@ struct Segment {
   }
 };
 
+// Parses integers by hand from big blocks of the input, which is a lot faster than std::cin
+class InputReader {
+ public:
+  explicit InputReader(std::FILE *in) : in_(in) {}
+
+  template<typename Integer>
+  Integer ReadInteger() {
+    int c = SkipSpaces();
+    bool negative = c == '-';
+
+    if (negative)
+      c = NextChar();
+
+    Integer value = 0;
+
+    // Accumulated with the sign, so that the minimum of a signed type doesn't overflow
+    for (; '0' <= c && c <= '9'; c = NextChar())
+      value = negative ? value * 10 - (c - '0') : value * 10 + (c - '0');
+
+    return value;
+  }
+
+  // Fixed width little-endian integer, the binary input is made of int64 only
+  int64_t ReadBinaryInteger() {
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); ++i)
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(NextChar())) << (8 * i);
+
+    return static_cast<int64_t>(value);
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 16;
+
+  int NextChar() {
+    if (position_ == size_) {
+      size_ = std::fread(buffer_, 1, kBufferSize, in_);
+      position_ = 0;
+
+      if (size_ == 0)
+        return EOF;
+    }
+
+    return buffer_[position_++];
+  }
+
+  int SkipSpaces() {
+    int c = NextChar();
+
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+      c = NextChar();
+
+    return c;
+  }
+
+  std::FILE *in_;
+  char buffer_[kBufferSize];
+  size_t position_ = 0;
+  size_t size_ = 0;
+};
+
+// Binary: u64 count, then little-endian int64 x and y for every point
+std::vector<Vector> ReadBinaryPoints(InputReader &reader) {
+  std::vector<Vector> points(reader.ReadBinaryInteger());
+
+  for (Vector &p : points) {
+    p.x = static_cast<Coordinate>(reader.ReadBinaryInteger());
+    p.y = static_cast<Coordinate>(reader.ReadBinaryInteger());
+  }
+
+  return points;
+}
+
 struct Event {
   Vector point;
   int id;
@@ -166,66 +247,618 @@ struct Event {
   }
 };
 
-std::optional<std::pair<int, int>> IntersectAdjacent(const std::set<Segment>::iterator &it,
-                                                     const std::set<Segment> &open_segments) {
-  if (it != open_segments.begin()) {
-    auto prev = std::prev(it);
+// Runs body(from, to) over threads_count contiguous chunks of [0, size) in parallel
+template<typename Body>
+void ParallelChunks(size_t size, size_t threads_count, Body body) {
+  std::vector<std::thread> threads;
+  threads_count = std::max<size_t>(1, threads_count);
+  size_t chunk = (size + threads_count - 1) / threads_count;
+
+  for (size_t from = 0; from < size; from += chunk)
+    threads.emplace_back(body, from, std::min(from + chunk, size));
+
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+// LSD radix sort by 16 bit digits. Every thread counts the digits of its chunk, then moves it
+// to the places, that the counts of all the chunks give, so equal digits keep their order
+void ParallelRadixSort(std::vector<uint64_t> &keys, size_t threads_count) {
+  constexpr size_t kDigitBits = 16;
+  constexpr size_t kDigits = 1 << kDigitBits;
+
+  if (keys.empty())
+    return;
+
+  // A chunk shorter than the counts of its digits costs more to count than to move
+  threads_count = std::max<size_t>(1, std::min(threads_count, keys.size() / kDigits));
+  size_t chunk = (keys.size() + threads_count - 1) / threads_count;
+  // As many counts as ParallelChunks makes chunks, so that none of them is left from the last pass
+  threads_count = (keys.size() + chunk - 1) / chunk;
+  std::vector<uint64_t> buffer(keys.size());
+  std::vector<std::vector<size_t>> counts(threads_count, std::vector<size_t>(kDigits));
+
+  for (size_t shift = 0; shift < 64; shift += kDigitBits) {
+    ParallelChunks(keys.size(), threads_count, [&](size_t from, size_t to) {
+      std::vector<size_t> &local = counts[from / chunk];
+      std::fill(local.begin(), local.end(), 0);
+
+      for (size_t i = from; i < to; ++i)
+        ++local[(keys[i] >> shift) & (kDigits - 1)];
+    });
+
+    size_t first_digit = (keys.front() >> shift) & (kDigits - 1);
+    size_t first_digit_count = 0;
+
+    for (const std::vector<size_t> &local : counts)
+      first_digit_count += local[first_digit];
+
+    if (first_digit_count == keys.size())
+      continue;
 
-    if (it->Intersects(*prev))
-      return std::make_pair(it->id, prev->id);
+    // Counts turn into the places, where the chunks start writing every digit
+    size_t position = 0;
+
+    for (size_t digit = 0; digit < kDigits; ++digit)
+      for (std::vector<size_t> &local : counts) {
+        size_t digit_count = local[digit];
+        local[digit] = position;
+        position += digit_count;
+      }
+
+    ParallelChunks(keys.size(), threads_count, [&](size_t from, size_t to) {
+      std::vector<size_t> &local = counts[from / chunk];
+
+      for (size_t i = from; i < to; ++i)
+        buffer[local[(keys[i] >> shift) & (kDigits - 1)]++] = keys[i];
+    });
+
+    keys.swap(buffer);
   }
+}
+
+// Events of all the segments in the order of Event::operator<. When x fits in 32 bits, every event
+// is packed into one key: x, then 0 for a start and 1 for an end, then the id in the lowest 31 bits
+std::vector<Event> SortedEvents(const std::vector<Segment> &segments, size_t threads_count) {
+  // Counting passes and threads don't pay off on small inputs
+  constexpr size_t kRadixThreshold = 1 << 16;
+  constexpr uint64_t kIdMask = (uint64_t(1) << 31) - 1;
+
+  bool fits = std::all_of(segments.begin(), segments.end(), [](const Segment &s) {
+    return std::numeric_limits<int32_t>::min() <= s.start.x && s.end.x <= std::numeric_limits<int32_t>::max();
+  });
 
-  if (it != --open_segments.end()) {
-    auto next = std::next(it);
+  std::vector<Event> events(2 * segments.size(), {{0, 0}, 0, false});
 
-    if (it->Intersects(*next))
-      return std::make_pair(it->id, next->id);
+  if (events.size() < kRadixThreshold || !fits) {
+    for (size_t i = 0; i < segments.size(); ++i) {
+      events[2 * i] = {segments[i].start, segments[i].id, true};
+      events[2 * i + 1] = {segments[i].end, segments[i].id, false};
+    }
+
+    std::sort(events.begin(), events.end());
+    return events;
   }
 
-  return std::nullopt;
+  std::vector<uint64_t> keys(events.size());
+
+  ParallelChunks(segments.size(), threads_count, [&](size_t from, size_t to) {
+    for (size_t i = from; i < to; ++i) {
+      const Segment &s = segments[i];
+      keys[2 * i] = static_cast<uint64_t>(s.start.x - std::numeric_limits<int32_t>::min()) << 32 | s.id;
+      keys[2 * i + 1] = static_cast<uint64_t>(s.end.x - std::numeric_limits<int32_t>::min()) << 32
+          | uint64_t(1) << 31 | s.id;
+    }
+  });
+
+  ParallelRadixSort(keys, threads_count);
+
+  ParallelChunks(keys.size(), threads_count, [&](size_t from, size_t to) {
+    for (size_t i = from; i < to; ++i) {
+      int id = keys[i] & kIdMask;
+      bool start = (keys[i] >> 31 & 1) == 0;
+      events[i] = {start ? segments[id].start : segments[id].end, id, start};
+    }
+  });
+
+  return events;
 }
 
-std::optional<std::pair<int, int>> FindIntersecting(const std::vector<Segment> &segments) {
-  std::vector<Event> events;
-  std::set<Segment> open_segments;
+// Open segments in the order of the sweep line, kept as ids in a skip list. The order is given
+// on insertion by a predicate, that tells if an open segment goes before the new one.
+// The node of a segment is its id, so erasing it or looking at its neighbours needs no search,
+// and all the links are in one pool instead of a tree node per segment
+class SweepStatus {
+ public:
+  static constexpr int kNone = -1;
+
+  explicit SweepStatus(size_t size)
+      : first_link_(size + 1), height_(size + 1), links_(kMaxHeight, {kHead, kNil}) {
+    height_[kHead] = kMaxHeight;
+    first_link_[kHead] = 0;
+    links_.reserve(kMaxHeight + 2 * size);
+  }
+
+  // Puts id right after the last segment, that is below it
+  template<typename Below>
+  void Insert(int id, Below below);
+  void Erase(int id);
 
-  for (Segment s : segments) {
-    events.push_back({s.start, s.id, true});
-    events.push_back({s.end, s.id, false});
+  // The last open segment, for which below(segment) is true, the order has to agree with it
+  template<typename Below>
+  int LastBelow(Below below) const;
+
+  int First() const { return ToId(Links(kHead)[0].next); }
+
+  int Prev(int id) const {
+    uint32_t node = Links(id + 1)[0].prev;
+    return node == kHead ? kNone : ToId(node);
   }
 
-  std::sort(events.begin(), events.end());
+  int Next(int id) const { return ToId(Links(id + 1)[0].next); }
+
+ private:
+  struct Link {
+    uint32_t prev;
+    uint32_t next;
+  };
+
+  static constexpr uint32_t kHead = 0;
+  static constexpr uint32_t kNil = UINT32_MAX;
+  static constexpr int kMaxHeight = 16;
+
+  static int ToId(uint32_t node) { return node == kNil ? kNone : static_cast<int>(node) - 1; }
+
+  Link *Links(uint32_t node) { return links_.data() + first_link_[node]; }
+  const Link *Links(uint32_t node) const { return links_.data() + first_link_[node]; }
 
-  for (Event e : events)
+  // Every level is a quarter of the one below
+  int RandomHeight() {
+    int height = 1;
+
+    for (uint32_t bits = random_(); height < kMaxHeight && (bits & 3) == 0; bits >>= 2)
+      ++height;
+
+    return height;
+  }
+
+  // links of the node are [first_link_, first_link_ + height_), node 0 is the head, node id + 1 is the segment id.
+  // A segment, that is inserted again, keeps its links
+  std::vector<uint32_t> first_link_;
+  std::vector<uint8_t> height_;
+  std::vector<Link> links_;
+  std::minstd_rand random_;
+};
+
+template<typename Below>
+void SweepStatus::Insert(int id, Below below) {
+  uint32_t node = id + 1;
+
+  if (height_[node] == 0) {
+    height_[node] = RandomHeight();
+    first_link_[node] = links_.size();
+    links_.resize(links_.size() + height_[node]);
+  }
+
+  uint32_t x = kHead;
+  // The node, that stopped the level above, is often next on this one too, and isn't asked again
+  uint32_t stop = kNil;
+
+  for (int level = kMaxHeight - 1; level >= 0; --level) {
+    uint32_t next = Links(x)[level].next;
+
+    for (; next != stop && below(next - 1); next = Links(x)[level].next)
+      x = next;
+
+    stop = next;
+
+    if (level < height_[node]) {
+      uint32_t after = Links(x)[level].next;
+      Links(node)[level] = {x, after};
+      Links(x)[level].next = node;
+
+      if (after != kNil)
+        Links(after)[level].prev = node;
+    }
+  }
+}
+
+template<typename Below>
+int SweepStatus::LastBelow(Below below) const {
+  uint32_t x = kHead;
+  uint32_t stop = kNil;
+
+  for (int level = kMaxHeight - 1; level >= 0; --level) {
+    uint32_t next = Links(x)[level].next;
+
+    for (; next != stop && below(next - 1); next = Links(x)[level].next)
+      x = next;
+
+    stop = next;
+  }
+
+  return x == kHead ? kNone : ToId(x);
+}
+
+void SweepStatus::Erase(int id) {
+  uint32_t node = id + 1;
+
+  for (int level = 0; level < height_[node]; ++level) {
+    Link link = Links(node)[level];
+    Links(link.prev)[level].next = link.next;
+
+    if (link.next != kNil)
+      Links(link.next)[level].prev = link.prev;
+  }
+}
+
+std::optional<std::pair<int, int>> IntersectAdjacent(int id, const SweepStatus &open_segments,
+                                                     const std::vector<Segment> &segments) {
+  int prev = open_segments.Prev(id);
+
+  if (prev != SweepStatus::kNone && segments[id].Intersects(segments[prev]))
+    return std::make_pair(id, prev);
+
+  int next = open_segments.Next(id);
+
+  if (next != SweepStatus::kNone && segments[id].Intersects(segments[next]))
+    return std::make_pair(id, next);
+
+  return std::nullopt;
+}
+
+// Segment ids are their indices
+std::optional<std::pair<int, int>> FindIntersecting(const std::vector<Segment> &segments) {
+  SweepStatus open_segments(segments.size());
+
+  for (Event e : SortedEvents(segments, std::max(1u, std::thread::hardware_concurrency())))
     if (e.start) {
-      auto it = open_segments.insert(segments[e.id]).first;
-      auto intersection = IntersectAdjacent(it, open_segments);
+      open_segments.Insert(e.id, [&](int other) { return segments[other] < segments[e.id]; });
+      auto intersection = IntersectAdjacent(e.id, open_segments, segments);
 
       if (intersection.has_value())
         return intersection.value();
     } else {
-      auto it = open_segments.find(segments[e.id]);
-      assert(it != open_segments.end());
-      auto intersection = IntersectAdjacent(it, open_segments);
+      auto intersection = IntersectAdjacent(e.id, open_segments, segments);
 
       if (intersection.has_value())
         return intersection.value();
       else
-        open_segments.erase(it);
+        open_segments.Erase(e.id);
     }
 
   return std::nullopt;
 }
 
-int main() {
-  int n;
-  std::cin >> n;
+// Bound on the coordinates of the segments, for which IntersectionSweep is exact
+constexpr Coordinate kMaxSweepCoordinate = 1'000'000'000;
+
+// Point with the rational coordinates x / d and y / d, d > 0.
+// Crossings of segments with |coordinates| <= kMaxSweepCoordinate and all the comparisons
+// below fit in 128 bits
+struct RationalPoint {
+  RationalPoint(__int128 x, __int128 y, __int128 d)
+      : x(x), y(y), d(d), approximate_x(static_cast<double>(x) / d), approximate_y(static_cast<double>(y) / d) {}
+
+  __int128 x;
+  __int128 y;
+  __int128 d;
+  // Rounded x / d and y / d, that tell the comparisons, which are far from a tie
+  double approximate_x;
+  double approximate_y;
+};
+
+// Way bigger than the rounding errors of the approximations, that are compared
+bool FarApart(double left, double right, double scale) {
+  return std::abs(left - right) > 1e-12 * scale;
+}
+
+bool FitsInt64(__int128 value) {
+  return INT64_MIN <= value && value <= INT64_MAX;
+}
+
+// Sign of a / b - c / d for b, d > 0. Small ones are cross multiplied, the rest go by
+// continued fractions, so nothing is multiplied
+int CompareFractions(__int128 a, __int128 b, __int128 c, __int128 d) {
+  if (FitsInt64(a) && FitsInt64(b) && FitsInt64(c) && FitsInt64(d)) {
+    __int128 left = a * d, right = c * b;
+    return left < right ? -1 : (left > right ? 1 : 0);
+  }
+
+  for (int sign = 1;; sign = -sign) {
+    __int128 a_floor = a / b - (a % b < 0 ? 1 : 0);
+    __int128 c_floor = c / d - (c % d < 0 ? 1 : 0);
+
+    if (a_floor != c_floor)
+      return a_floor < c_floor ? -sign : sign;
+
+    a -= a_floor * b;
+    c -= c_floor * d;
+
+    if (a == 0 || c == 0)
+      return a == c ? 0 : (a == 0 ? -sign : sign);
+
+    // a / b < c / d  <=>  b / a > d / c
+    std::swap(a, b);
+    std::swap(c, d);
+  }
+}
+
+// By x, then by y, as the sweep goes
+int ComparePoints(const RationalPoint &left, const RationalPoint &right) {
+  if (FarApart(left.approximate_x, right.approximate_x, std::abs(left.approximate_x) + std::abs(right.approximate_x)))
+    return left.approximate_x < right.approximate_x ? -1 : 1;
+
+  int x_comparison = CompareFractions(left.x, left.d, right.x, right.d);
+
+  if (x_comparison != 0)
+    return x_comparison;
+
+  if (FarApart(left.approximate_y, right.approximate_y, std::abs(left.approximate_y) + std::abs(right.approximate_y)))
+    return left.approximate_y < right.approximate_y ? -1 : 1;
+
+  return CompareFractions(left.y, left.d, right.y, right.d);
+}
+
+// Bentley-Ottmann sweep, that reports all the intersecting pairs. Events are the end points and
+// the crossings of the neighbours in the status, all in exact rational points. The open segments
+// are ordered by their y at the event point, then by the slope, so that the order is the one
+// right after the event, vertical segments being on the top of the ones through the point
+class IntersectionSweep {
+ public:
+  explicit IntersectionSweep(const std::vector<Segment> &segments);
+
+  // visitor(first, second) for every intersecting pair of ids, once, O((n + k) log n) for k pairs
+  template<typename Visitor>
+  void Run(Visitor visitor);
+
+ private:
+  struct SweepEvent {
+    RationalPoint point;
+    // starting segment, or SweepStatus::kNone for an end or a crossing
+    int id;
+
+    bool operator>(const SweepEvent &other) const {
+      return ComparePoints(point, other.point) > 0;
+    }
+  };
+
+  static RationalPoint ToPoint(const Vector &v) {
+    return {v.x, v.y, 1};
+  }
+
+  // Sign of the y of the segment at x of the point minus y of the point. Vertical segments
+  // in the status always go through the point
+  int CompareYAt(int id, const RationalPoint &p) const;
+  // Vertical ones are the steepest
+  bool SlopeLess(int left, int right) const;
+  // If other goes before id, that goes through p, in the order of the status right after p
+  bool Below(int other, int id, const RationalPoint &p) const;
+  bool StartsAt(int id, const RationalPoint &p) const;
+  bool EndsAt(int id, const RationalPoint &p) const;
+  void AddCrossing(int left, int right, const RationalPoint &p);
+
+  const std::vector<Segment> &segments_;
+  // end points in the order of the sweep
+  std::vector<Vector> first_;
+  std::vector<Vector> last_;
+  std::vector<double> slope_;
+  SweepStatus status_;
+  std::priority_queue<SweepEvent, std::vector<SweepEvent>, std::greater<>> events_;
+};
+
+IntersectionSweep::IntersectionSweep(const std::vector<Segment> &segments)
+    : segments_(segments), status_(segments.size()) {
+  first_.reserve(segments.size());
+  last_.reserve(segments.size());
+  slope_.reserve(segments.size());
+
+  for (const Segment &s : segments) {
+    first_.push_back(std::min(s.start, s.end));
+    last_.push_back(std::max(s.start, s.end));
+    Vector dir = last_.back() - first_.back();
+    slope_.push_back(dir.x == 0 ? 0.0 : static_cast<double>(dir.y) / dir.x);
+  }
+}
+
+int IntersectionSweep::CompareYAt(int id, const RationalPoint &p) const {
+  const Vector &start = first_[id];
+  __int128 dx = last_[id].x - start.x;
+  __int128 dy = last_[id].y - start.y;
+
+  if (dx == 0)
+    return 0;
+
+  double y = start.y + (p.approximate_x - start.x) * slope_[id];
+  double scale = std::abs(start.y) + (std::abs(p.approximate_x) + std::abs(start.x)) * std::abs(slope_[id])
+      + std::abs(p.approximate_y);
+
+  if (FarApart(y, p.approximate_y, scale))
+    return y < p.approximate_y ? -1 : 1;
+
+  // y = start.y + (p.x / p.d - start.x) * dy / dx
+  __int128 numerator = start.y * dx * p.d + (p.x - start.x * p.d) * dy;
+  return CompareFractions(numerator, dx * p.d, p.y, p.d);
+}
+
+bool IntersectionSweep::SlopeLess(int left, int right) const {
+  Vector left_dir = last_[left] - first_[left];
+  Vector right_dir = last_[right] - first_[right];
+
+  if (left_dir.x == 0 || right_dir.x == 0)
+    return left_dir.x != 0 && right_dir.x == 0;
+
+  return static_cast<__int128>(left_dir.y) * right_dir.x < static_cast<__int128>(right_dir.y) * left_dir.x;
+}
+
+bool IntersectionSweep::Below(int other, int id, const RationalPoint &p) const {
+  int y_comparison = CompareYAt(other, p);
+
+  if (y_comparison != 0)
+    return y_comparison < 0;
+
+  if (SlopeLess(other, id) || SlopeLess(id, other))
+    return SlopeLess(other, id);
+
+  return other < id;
+}
+
+bool IntersectionSweep::StartsAt(int id, const RationalPoint &p) const {
+  return p.x == first_[id].x * p.d && p.y == first_[id].y * p.d;
+}
+
+bool IntersectionSweep::EndsAt(int id, const RationalPoint &p) const {
+  return p.x == last_[id].x * p.d && p.y == last_[id].y * p.d;
+}
+
+void IntersectionSweep::AddCrossing(int left, int right, const RationalPoint &p) {
+  if (left == SweepStatus::kNone || right == SweepStatus::kNone)
+    return;
+
+  Vector a = first_[left];
+  Vector b = first_[right];
+  __int128 a_dx = last_[left].x - a.x, a_dy = last_[left].y - a.y;
+  __int128 b_dx = last_[right].x - b.x, b_dy = last_[right].y - b.y;
+  __int128 w_x = b.x - a.x, w_y = b.y - a.y;
+
+  // a + t * a_dir = b + u * b_dir, t = t_num / d, u = u_num / d
+  __int128 d = a_dx * b_dy - a_dy * b_dx;
+  __int128 t_num = w_x * b_dy - w_y * b_dx;
+  __int128 u_num = w_x * a_dy - w_y * a_dx;
+
+  // Parallel ones never swap
+  if (d == 0)
+    return;
+
+  if (d < 0) {
+    d = -d;
+    t_num = -t_num;
+    u_num = -u_num;
+  }
+
+  if (t_num < 0 || t_num > d || u_num < 0 || u_num > d)
+    return;
+
+  RationalPoint crossing{a.x * d + a_dx * t_num, a.y * d + a_dy * t_num, d};
+
+  if (ComparePoints(crossing, p) > 0)
+    events_.push({crossing, SweepStatus::kNone});
+}
+
+template<typename Visitor>
+void IntersectionSweep::Run(Visitor visitor) {
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    events_.push({ToPoint(first_[i]), static_cast<int>(i)});
+    events_.push({ToPoint(last_[i]), SweepStatus::kNone});
+  }
+
+  std::vector<int> starting;
+  std::vector<int> through;
+  std::vector<int> inserted;
+
+  while (!events_.empty()) {
+    RationalPoint p = events_.top().point;
+    starting.clear();
+    through.clear();
+    inserted.clear();
+
+    for (; !events_.empty() && ComparePoints(events_.top().point, p) == 0; events_.pop())
+      if (events_.top().id != SweepStatus::kNone)
+        starting.push_back(events_.top().id);
+
+    // Segments, that go through p, are together in the status
+    int below = status_.LastBelow([&](int other) { return CompareYAt(other, p) < 0; });
+
+    for (int id = below == SweepStatus::kNone ? status_.First() : status_.Next(below);
+         id != SweepStatus::kNone && CompareYAt(id, p) == 0; id = status_.Next(id))
+      through.push_back(id);
+
+    // A collinear pair overlaps, and is reported only where the overlap starts
+    starting.insert(starting.end(), through.begin(), through.end());
+
+    for (size_t i = 0; i < starting.size(); ++i)
+      for (size_t j = i + 1; j < starting.size(); ++j) {
+        int left = starting[i], right = starting[j];
+        Vector left_dir = last_[left] - first_[left];
+        Vector right_dir = last_[right] - first_[right];
+
+        if (left_dir.Orient(right_dir) != SameAngle || StartsAt(left, p) || StartsAt(right, p))
+          visitor(left, right);
+      }
+
+    for (int id : through)
+      status_.Erase(id);
+
+    // Single points are never open
+    for (int id : starting)
+      if (!EndsAt(id, p))
+        inserted.push_back(id);
+
+    for (int id : inserted)
+      status_.Insert(id, [&](int other) { return Below(other, id, p); });
+
+    int lowest = below == SweepStatus::kNone ? status_.First() : status_.Next(below);
+
+    if (inserted.empty()) {
+      AddCrossing(below, lowest, p);
+      continue;
+    }
+
+    int highest = lowest;
+
+    for (size_t i = 1; i < inserted.size(); ++i)
+      highest = status_.Next(highest);
+
+    AddCrossing(below, lowest, p);
+    AddCrossing(highest, status_.Next(highest), p);
+  }
+}
+
+// Every intersecting pair of ids goes to visitor(first, second) once, ids are the indices.
+// Crossings of coordinates beyond kMaxSweepCoordinate in absolute value would overflow the 128 bit
+// rational points of the sweep, so such inputs fall back to checking every pair, which is quadratic
+template<typename Visitor>
+void ForEachIntersection(const std::vector<Segment> &segments, Visitor visitor) {
+  auto in_range = [](Coordinate value) { return -kMaxSweepCoordinate <= value && value <= kMaxSweepCoordinate; };
+
+  if (!std::all_of(segments.begin(), segments.end(), [&in_range](const Segment &s) {
+    return in_range(s.start.x) && in_range(s.start.y) && in_range(s.end.x) && in_range(s.end.y);
+  })) {
+    for (size_t i = 0; i < segments.size(); ++i)
+      for (size_t j = i + 1; j < segments.size(); ++j)
+        if (segments[i].Intersects(segments[j]))
+          visitor(static_cast<int>(i), static_cast<int>(j));
+
+    return;
+  }
+
+  IntersectionSweep sweep(segments);
+  sweep.Run(visitor);
+}
+
+// With --binary the input is a single block of ReadBinaryPoints with the two ends of every segment
+int main(int argc, char **argv) {
+  InputReader reader(stdin);
   std::vector<Segment> segments;
 
-  for (int i = 0; i < n; ++i) {
-    Coordinate x1, y1, x2, y2;
-    std::cin >> x1 >> y1 >> x2 >> y2;
-    segments.push_back({{x1, y1}, {x2, y2}, i});
+  if (argc > 1 && std::string(argv[1]) == "--binary") {
+    std::vector<Vector> ends = ReadBinaryPoints(reader);
+    segments.reserve(ends.size() / 2);
+
+    // An unpaired last end is dropped
+    for (size_t i = 0; i + 1 < ends.size(); i += 2)
+      segments.push_back({ends[i], ends[i + 1], static_cast<int>(i / 2)});
+  } else {
+    int n = reader.ReadInteger<int>();
+    segments.reserve(n);
+
+    for (int i = 0; i < n; ++i) {
+      Coordinate x1 = reader.ReadInteger<Coordinate>();
+      Coordinate y1 = reader.ReadInteger<Coordinate>();
+      Coordinate x2 = reader.ReadInteger<Coordinate>();
+      Coordinate y2 = reader.ReadInteger<Coordinate>();
+      segments.push_back({{x1, y1}, {x2, y2}, i});
+    }
   }
 
   auto intersection = FindIntersecting(segments);
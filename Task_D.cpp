@@ -6,22 +6,28 @@
 #include <string>
 #include <tuple>
 #include <unordered_set>
+#include <algorithm>
 
 constexpr char kFirstLetter = 'a' - 1;
 constexpr size_t kAlphabetSize = 27;
+constexpr size_t kLettersCount = 26;
 
 size_t IndexOf(char c) { return c - kFirstLetter; }
+// Symbols of an already encoded text are their own indices
+size_t IndexOf(size_t symbol) { return symbol; }
 
 //         suffix_array       , classes            , class_count
-std::tuple<std::vector<size_t>, std::vector<size_t>, size_t> SortFirstLetter(const std::string &s) {
+template<typename Text>
+std::tuple<std::vector<size_t>, std::vector<size_t>, size_t> SortFirstLetter(const Text &s,
+                                                                             size_t alphabet_size) {
   std::vector<size_t> suffix_array(s.size());
   std::vector<size_t> classes(s.size());
-  std::vector<size_t> counts(kAlphabetSize);
+  std::vector<size_t> counts(alphabet_size);
 
-  for (char c : s)
+  for (auto c : s)
     ++counts[IndexOf(c)];
 
-  for (size_t i = 1; i < kAlphabetSize; ++i)
+  for (size_t i = 1; i < alphabet_size; ++i)
     counts[i] += counts[i - 1];
 
   for (size_t i = 0; i < s.size(); ++i)
@@ -42,9 +48,10 @@ std::tuple<std::vector<size_t>, std::vector<size_t>, size_t> SortFirstLetter(con
   return {suffix_array, classes, next_class + 1};
 }
 
-// Assuming that s ends in the character that is right before 'a' in the encoding table ('a' - 1)
-std::vector<size_t> BuildSuffixArray(const std::string &s) {
-  auto[suffix_array, classes, classes_count] = SortFirstLetter(s);
+// Assuming that s ends in the unique lowest symbol (for strings - 'a' - 1)
+template<typename Text>
+std::vector<size_t> BuildSuffixArray(const Text &s, size_t alphabet_size = kAlphabetSize) {
+  auto[suffix_array, classes, classes_count] = SortFirstLetter(s, alphabet_size);
   std::vector<size_t> new_suffix_array(s.size());
   std::vector<size_t> new_classes(s.size());
 
@@ -98,7 +105,8 @@ std::vector<size_t> ReverseSuffixArray(const std::vector<size_t> &suffix_array)
 }
 
 // result[i] = LCP(suffix_array[i], suffix_array[i + 1])
-std::vector<size_t> Kasai(const std::string &s, const std::vector<size_t> &suffix_array) {
+template<typename Text>
+std::vector<size_t> Kasai(const Text &s, const std::vector<size_t> &suffix_array) {
   std::vector<size_t> suffix_order = ReverseSuffixArray(suffix_array);
   std::vector<size_t> lcp(s.size() - 1);
   size_t cur_lcp = 0;
@@ -144,6 +152,106 @@ size_t CountSubStrings(std::string s) {
   return CountSubStrings(s, suffix_array, lcp);
 }
 
+struct CollectionStatistics {
+  size_t distinct_total = 0;
+  std::vector<size_t> distinct_per_document;
+  // document_frequency[f] - number of distinct substrings, that occur in exactly f documents
+  std::vector<size_t> document_frequency;
+};
+
+struct LcpInterval {
+  size_t lcp;
+  size_t left;
+  // pairs of neighbouring (in suffix array) suffixes of the same document inside the interval
+  size_t repeats;
+};
+
+// Every document is terminated with its own separator, so no common prefix can cross documents.
+// Document i gets separator (documents.size() - 1 - i) and letters go after all separators,
+// that way the text still ends in the unique lowest symbol
+CollectionStatistics CountSubStrings(const std::vector<std::string> &documents) {
+  size_t documents_count = documents.size();
+  CollectionStatistics result;
+  result.distinct_per_document.resize(documents_count);
+  result.document_frequency.resize(documents_count + 1);
+
+  if (documents.empty())
+    return result;
+
+  std::vector<size_t> text;
+  std::vector<size_t> document_of;
+  std::vector<size_t> document_end(documents_count);
+
+  for (size_t i = 0; i < documents_count; ++i) {
+    for (char c : documents[i]) {
+      text.push_back(documents_count + c - 'a');
+      document_of.push_back(i);
+    }
+
+    document_end[i] = text.size();
+    text.push_back(documents_count - 1 - i);
+    document_of.push_back(i);
+  }
+
+  size_t n = text.size();
+  std::vector<size_t> suffix_array = BuildSuffixArray(text, documents_count + kLettersCount);
+  std::vector<size_t> lcp = Kasai(text, suffix_array);
+
+  auto suffix_length = [&](size_t suffix) { return document_end[document_of[suffix]] - suffix; };
+  auto lcp_before = [&](size_t i) { return 0 < i && i < n ? lcp[i - 1] : 0; };
+
+  // Bottom-up traversal of lcp-intervals. The deepest interval containing two suffixes is their LCA,
+  // so it gives both their LCP and the place where a document has to be counted only once.
+  // Separators are the first documents_count suffixes and have zero length, so they are skipped.
+  std::vector<size_t> last_seen(documents_count, n);
+  std::vector<LcpInterval> stack{{0, 0, 0}};
+
+  for (size_t i = documents_count; i <= n; ++i) {
+    size_t cur_lcp = lcp_before(i);
+    size_t left = i - 1;
+    size_t carried_repeats = 0;
+
+    while (cur_lcp < stack.back().lcp) {
+      LcpInterval interval = stack.back();
+      stack.pop_back();
+      size_t parent_lcp = std::max(cur_lcp, stack.back().lcp);
+      result.document_frequency[i - interval.left - interval.repeats] += interval.lcp - parent_lcp;
+      left = interval.left;
+
+      if (cur_lcp <= stack.back().lcp)
+        stack.back().repeats += interval.repeats;
+      else
+        carried_repeats = interval.repeats;
+    }
+
+    if (cur_lcp > stack.back().lcp)
+      stack.push_back({cur_lcp, left, carried_repeats});
+
+    if (i == n)
+      break;
+
+    size_t suffix = suffix_array[i];
+    size_t document = document_of[suffix];
+    size_t length = suffix_length(suffix);
+    result.distinct_per_document[document] += length;
+    result.distinct_total += length - cur_lcp;
+    result.document_frequency[1] += length - std::max(cur_lcp, lcp_before(i + 1));
+
+    if (last_seen[document] != n) {
+      auto lca = std::upper_bound(stack.begin(), stack.end(), last_seen[document],
+                                  [](size_t pos, const LcpInterval &interval) {
+                                    return pos < interval.left;
+                                  }) - 1;
+      result.distinct_per_document[document] -= lca->lcp;
+      ++lca->repeats;
+    }
+
+    last_seen[document] = i;
+  }
+
+  return result;
+}
+
 int main() {
   std::string s;
   std::cin >> s;
@@ -3,170 +3,395 @@
 //
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <tuple>
+#include <string>
+#include <string_view>
 #include <optional>
-#include <map>
-#include <memory>
+#include <limits>
+#include <cstdint>
+#include <cassert>
 
-struct Node;
+using NodeId = uint32_t;
 
-struct Transition {
-  Transition() = default;
-  explicit Transition(std::unique_ptr<Node> &&node,
-                      size_t start,
-                      std::optional<size_t> end)
-      : node(std::move(node)), start(start), end(end) {}
+constexpr NodeId kRootId = 0;
+constexpr NodeId kNoNode = std::numeric_limits<NodeId>::max();
+constexpr uint32_t kOpenEnd = std::numeric_limits<uint32_t>::max();
 
-  size_t Length() const { return end.value() - start; }
+// Every node except the root stores the edge leading into it,
+// children form a doubly linked list sorted by the first char of their edges.
+// Leaves have end == kOpenEnd, which means they grow together with the text
+struct Node {
+  Node() = default;
+  Node(char c, uint32_t start, uint32_t end) : c(c), start(start), end(end) {}
 
-  std::unique_ptr<Node> node = nullptr;
-  // [start, end)
-  size_t start = 0;
-  std::optional<size_t> end = std::nullopt;
-};
+  size_t Length() const { return end - start; }
 
-struct Node {
-  std::map<char, Transition> to;
-  Node *suffix_link = nullptr;
-  size_t id = 0;
+  char c = '\0';
+  // [start, end)
+  uint32_t start = 0;
+  uint32_t end = kOpenEnd;
+  NodeId suffix_link = kNoNode;
+  NodeId first_child = kNoNode;
+  NodeId next_sibling = kNoNode;
+  NodeId prev_sibling = kNoNode;
 };
 
 struct ActivePoint {
-  Node *node = nullptr;
+  NodeId node = kRootId;
   // c == \0 <=> length = 0 and that we don't have an edge to go to
   char c = '\0';
+  // the child of node, that the edge by c leads to, cached to not look it up on every step
+  NodeId edge = kNoNode;
   size_t length = 0;
 };
 
-class SuffixTree {
+// Open addressing from (node, first char of the edge) to the child. An entry keeps only the two
+// ids and the char is checked on the child, which the caller reads right after anyway, so a search
+// is about one cache miss instead of a walk over the siblings spread across the pool
+class EdgeTable {
  public:
-  SuffixTree(const std::string &s) : s_(s) {
-    ap_.node = &root_;
-    Initialize();
+  EdgeTable() { Rehash(16, {}); }
+
+  NodeId Find(NodeId from, char c, const std::vector<Node> &nodes) const {
+    for (size_t i = Slot(from, c);; i = (i + 1) & (entries_.size() - 1)) {
+      if (entries_[i].from == from && nodes[entries_[i].child].c == c)
+        return entries_[i].child;
+
+      if (entries_[i].from == kNoNode)
+        return kNoNode;
+    }
   }
 
-  void PrintTree(std::ostream &out, size_t first_size);
+  // Adds the edge or redirects it, if from already has one by the char of child
+  void Set(NodeId from, NodeId child, const std::vector<Node> &nodes) {
+    if (4 * (size_ + 1) > 3 * entries_.size())
+      Rehash(2 * entries_.size(), nodes);
+
+    char c = nodes[child].c;
+    size_t i = Slot(from, c);
+
+    for (; entries_[i].from != kNoNode; i = (i + 1) & (entries_.size() - 1))
+      if (entries_[i].from == from && nodes[entries_[i].child].c == c)
+        break;
+
+    if (entries_[i].from == kNoNode)
+      ++size_;
+
+    entries_[i] = {from, child};
+  }
+
+  void Reserve(size_t size, const std::vector<Node> &nodes) {
+    size_t capacity = entries_.size();
+
+    while (3 * capacity < 4 * size)
+      capacity *= 2;
+
+    if (capacity != entries_.size())
+      Rehash(capacity, nodes);
+  }
 
  private:
-  void Initialize();
+  struct Entry {
+    NodeId from = kNoNode;
+    NodeId child = kNoNode;
+  };
+
+  // The top bits of the Fibonacci hash, the capacity is a power of two
+  size_t Slot(NodeId from, char c) const {
+    return ((static_cast<uint64_t>(from) << 8 | static_cast<unsigned char>(c)) * 0x9e3779b97f4a7c15ULL) >> shift_;
+  }
+
+  void Rehash(size_t capacity, const std::vector<Node> &nodes) {
+    std::vector<Entry> entries(capacity);
+    entries.swap(entries_);
+    shift_ = 64;
+
+    for (size_t i = capacity; i > 1; i /= 2)
+      --shift_;
+
+    for (const Entry &entry : entries)
+      if (entry.from != kNoNode) {
+        size_t i = Slot(entry.from, nodes[entry.child].c);
+
+        for (; entries_[i].from != kNoNode; i = (i + 1) & (entries_.size() - 1)) {}
+
+        entries_[i] = entry;
+      }
+  }
+
+  std::vector<Entry> entries_;
+  size_t size_ = 0;
+  int shift_ = 64;
+};
 
+// Ukkonen's algorithm is online, so the tree can be queried between appends.
+// Until the text ends with a unique symbol, some suffixes are implicit (not leaves)
+class SuffixTree {
+ public:
+  SuffixTree() { nodes_.emplace_back('\0', 0, 0); }
+  explicit SuffixTree(std::string_view s) : SuffixTree() { Append(s); }
+
+  void Append(char c);
+  void Append(std::string_view s);
+
+  const std::string &Text() const { return s_; }
+  bool Contains(std::string_view pattern) const;
+  size_t CountOccurrences(std::string_view pattern) const;
+  // Starting positions of all the occurrences in no particular order
+  std::vector<size_t> FindOccurrences(std::string_view pattern) const;
+
+  void PrintTree(std::ostream &out, size_t first_size) const;
+  // The same edges as PrintTree, but as fixed width little-endian integers, preceded by the text.
+  // Offsets are into the whole text, PrintTree cuts them at first_size for its output only
+  void WriteBinary(std::ostream &out) const;
+  // Suffix links are not stored, so the loaded tree can be queried, but not appended to.
+  // Reads exactly the bytes WriteBinary wrote, nullopt if they are cut short or don't form a tree
+  static std::optional<SuffixTree> ReadBinary(std::istream &in);
+
+ private:
+  template<typename Visitor>
+  void ForEachEdge(Visitor visitor) const;
+
+  size_t EdgeEnd(NodeId node) const;
+  size_t EdgeLength(NodeId node) const { return EdgeEnd(node) - nodes_[node].start; }
+  //            node  , string depth at the end of its edge
+  std::optional<std::pair<NodeId, size_t>> Locate(std::string_view pattern) const;
+  template<typename Visitor>
+  void ForEachOccurrence(std::string_view pattern, Visitor visitor) const;
+
+  NodeId NewNode(char c, size_t start, size_t end);
+  NodeId FindChild(NodeId from, char c) const;
+  // Puts child between the siblings prev and next, kNoNode for the ends of the list
+  void LinkChild(NodeId from, NodeId prev, NodeId child, NodeId next);
+  void AddChild(NodeId from, NodeId child);
+  void ReplaceChild(NodeId from, NodeId old_child, NodeId new_child);
+
+  void SetActiveEdge(char c);
+  NodeId NextEdge(char c) const;
   void AddSymbol(char c, size_t index);
-  void FinishString(Node &from);
-  bool NeedToSplit(char c) const;
+  bool NeedToSplit(char c, NodeId next_edge) const;
   void FixLengthOverflow(size_t index);
 
-  void PrintNode(Node &from,
-                 std::ostream &out,
-                 size_t first_size,
-                 size_t &node_id);
-
-  const std::string &s_;
-  Node root_{};
+  std::string s_;
+  // nodes_[kRootId] is the root
+  std::vector<Node> nodes_;
+  // The same edges as the sibling lists, which keep the children sorted for the traversals
+  EdgeTable edges_;
   ActivePoint ap_{};
   size_t remainder_ = 0;
-  size_t node_count_ = 0;
+  bool has_suffix_links_ = true;
+};
+
+// Edge into the node with the next id in pre-order
+struct EdgeRow {
+  size_t parent_id;
+  // [start, end) in the whole text
+  size_t start;
+  size_t end;
 };
 
-void SuffixTree::Initialize() {
-  ++node_count_;
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(std::ostream &out) : out_(out) { buffer_.reserve(kBufferSize); }
+  ~BinaryWriter() { Flush(); }
 
-  for (size_t i = 0; i < s_.size(); ++i)
-    AddSymbol(s_[i], i);
+  void WriteInteger(uint64_t value, size_t bytes);
+  void WriteBytes(std::string_view bytes);
+  void Flush();
 
-  FinishString(root_);
+ private:
+  static constexpr size_t kBufferSize = 1 << 20;
+
+  std::ostream &out_;
+  std::string buffer_;
+};
+
+// Buffers ahead only the bytes announced with Expect, so whatever follows in the stream stays there.
+// A read past the end of the stream returns zeros and marks the reader as failed
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::istream &in) : in_(in), buffer_(kBufferSize) {}
+
+  void Expect(uint64_t bytes) { expected_ = bytes; }
+  uint64_t ReadInteger(size_t bytes);
+  std::string ReadBytes(size_t size);
+  bool Failed() const { return failed_; }
+
+ private:
+  static constexpr size_t kBufferSize = 1 << 20;
+
+  // Makes at least bytes available in the buffer
+  void Refill(size_t bytes);
+  // Reads straight from the stream, minding the announced bytes
+  size_t ReadStream(char *data, size_t size);
+
+  std::istream &in_;
+  std::vector<char> buffer_;
+  size_t position_ = 0;
+  size_t size_ = 0;
+  // Announced bytes, that are still in the stream
+  uint64_t expected_ = 0;
+  bool failed_ = false;
+};
+
+void SuffixTree::Append(char c) {
+  assert(has_suffix_links_);
+  s_.push_back(c);
+  AddSymbol(c, s_.size() - 1);
+}
+
+void SuffixTree::Append(std::string_view s) {
+  s_.reserve(s_.size() + s.size());
+  // A suffix tree has at most 2n nodes, usually a lot less
+  nodes_.reserve(nodes_.size() + s.size() + s.size() / 2);
+  edges_.Reserve(nodes_.capacity(), nodes_);
+
+  for (char c : s)
+    Append(c);
+}
+
+size_t SuffixTree::EdgeEnd(NodeId node) const {
+  return nodes_[node].end == kOpenEnd ? s_.size() : nodes_[node].end;
+}
+
+NodeId SuffixTree::NewNode(char c, size_t start, size_t end) {
+  nodes_.emplace_back(c, start, end);
+  return nodes_.size() - 1;
+}
+
+NodeId SuffixTree::FindChild(NodeId from, char c) const {
+  return edges_.Find(from, c, nodes_);
+}
+
+void SuffixTree::LinkChild(NodeId from, NodeId prev, NodeId child, NodeId next) {
+  nodes_[child].prev_sibling = prev;
+  nodes_[child].next_sibling = next;
+
+  if (prev == kNoNode)
+    nodes_[from].first_child = child;
+  else
+    nodes_[prev].next_sibling = child;
+
+  if (next != kNoNode)
+    nodes_[next].prev_sibling = child;
+}
+
+void SuffixTree::AddChild(NodeId from, NodeId child) {
+  NodeId prev = kNoNode;
+  NodeId next = nodes_[from].first_child;
+
+  while (next != kNoNode && nodes_[next].c < nodes_[child].c) {
+    prev = next;
+    next = nodes_[next].next_sibling;
+  }
+
+  LinkChild(from, prev, child, next);
+  edges_.Set(from, child, nodes_);
 }
 
-bool SuffixTree::NeedToSplit(char c) const {
+// No walk over the siblings, the old child knows its neighbours
+void SuffixTree::ReplaceChild(NodeId from, NodeId old_child, NodeId new_child) {
+  edges_.Set(from, new_child, nodes_);
+  LinkChild(from, nodes_[old_child].prev_sibling, new_child, nodes_[old_child].next_sibling);
+  nodes_[old_child].prev_sibling = kNoNode;
+  nodes_[old_child].next_sibling = kNoNode;
+}
+
+void SuffixTree::SetActiveEdge(char c) {
+  ap_.c = c;
+  ap_.edge = c ? FindChild(ap_.node, c) : kNoNode;
+}
+
+// The edge, that c would be added to, kNoNode if there is none
+NodeId SuffixTree::NextEdge(char c) const {
+  return ap_.c ? ap_.edge : FindChild(ap_.node, c);
+}
+
+bool SuffixTree::NeedToSplit(char c, NodeId next_edge) const {
   if (ap_.c)
-    return s_[ap_.node->to.at(ap_.c).start + ap_.length] != c;
+    return s_[nodes_[next_edge].start + ap_.length] != c;
   else
-    return ap_.node->to.find(c) == ap_.node->to.end();
+    return next_edge == kNoNode;
 }
 
 void SuffixTree::FixLengthOverflow(size_t index) {
-  while (ap_.c && ap_.node->to[ap_.c].end.has_value()
-      && ap_.length > ap_.node->to[ap_.c].end.value() - ap_.node->to[ap_.c].start) {
-    ActivePoint new_ap{};
-    size_t node_len = ap_.node->to[ap_.c].Length();
-    char next_c = s_[index - ap_.length + node_len];
-    new_ap.node = ap_.node->to[ap_.c].node.get();
-    new_ap.length = ap_.length - node_len;
-    new_ap.c = next_c;
-    ap_ = new_ap;
+  while (ap_.c && nodes_[ap_.edge].end != kOpenEnd && ap_.length > nodes_[ap_.edge].Length()) {
+    size_t node_len = nodes_[ap_.edge].Length();
+    ap_.node = ap_.edge;
+    ap_.length -= node_len;
+    SetActiveEdge(s_[index - ap_.length]);
   }
 
-  if (ap_.c) {
-    Transition &to_c = ap_.node->to[ap_.c];
-
-    if (to_c.end.has_value() && ap_.length == to_c.end.value() - to_c.start) {
-      ap_.node = to_c.node.get();
-      ap_.length = 0;
-      ap_.c = '\0';
-    }
+  if (ap_.c && nodes_[ap_.edge].end != kOpenEnd && ap_.length == nodes_[ap_.edge].Length()) {
+    ap_.node = ap_.edge;
+    ap_.length = 0;
+    ap_.c = '\0';
+    ap_.edge = kNoNode;
   }
 }
 
 void SuffixTree::AddSymbol(char c, size_t index) {
   ++remainder_;
-  Node *prev_created = nullptr;
+  NodeId prev_created = kNoNode;
 
   while (remainder_ > 0) {
-    if (NeedToSplit(c)) {
-      if (ap_.c) {
-        Transition &to_c = ap_.node->to[ap_.c];
+    NodeId next_edge = NextEdge(c);
 
-        size_t split_end = to_c.start + ap_.length;
+    if (NeedToSplit(c, next_edge)) {
+      if (ap_.c) {
+        NodeId to_c = next_edge;
 
-        auto other_node = std::make_unique<Node>();
-        to_c.node.swap(other_node);
-        to_c.node->to.emplace(
-            std::make_pair(s_[split_end], Transition(std::move(other_node), split_end, to_c.end))
-        );
-        to_c.end = split_end;
-        to_c.node->to.emplace(
-            std::make_pair(c, Transition(std::make_unique<Node>(), index, std::nullopt))
-        );
+        size_t split_end = nodes_[to_c].start + ap_.length;
 
-        node_count_ += 2;
+        NodeId middle = NewNode(ap_.c, nodes_[to_c].start, split_end);
+        NodeId leaf = NewNode(c, index, kOpenEnd);
+        ReplaceChild(ap_.node, to_c, middle);
+        nodes_[to_c].c = s_[split_end];
+        nodes_[to_c].start = split_end;
+        AddChild(middle, to_c);
+        AddChild(middle, leaf);
 
-        if (prev_created)
-          prev_created->suffix_link = to_c.node.get();
+        if (prev_created != kNoNode)
+          nodes_[prev_created].suffix_link = middle;
 
-        prev_created = to_c.node.get();
+        prev_created = middle;
       } else {
-        ap_.node->to.emplace(
-            std::make_pair(c, Transition(std::make_unique<Node>(), index, std::nullopt))
-        );
-        ++node_count_;
+        NodeId leaf = NewNode(c, index, kOpenEnd);
+        AddChild(ap_.node, leaf);
 
-        if (prev_created && ap_.node != &root_)
-          prev_created->suffix_link = ap_.node;
+        if (prev_created != kNoNode && ap_.node != kRootId)
+          nodes_[prev_created].suffix_link = ap_.node;
 
-        prev_created = nullptr;
+        prev_created = kNoNode;
       }
 
       --remainder_;
 
-      if (ap_.node == &root_) {
+      if (ap_.node == kRootId) {
         if (ap_.length > 0)
           --ap_.length;
 
-        ap_.c = ap_.length ? s_[index - remainder_ + 1] : '\0';
+        SetActiveEdge(ap_.length ? s_[index - remainder_ + 1] : '\0');
       } else {
-        ap_.node = ap_.node->suffix_link ? ap_.node->suffix_link : &root_;
+        NodeId link = nodes_[ap_.node].suffix_link;
+        ap_.node = link != kNoNode ? link : kRootId;
+        SetActiveEdge(ap_.c);
       }
 
       FixLengthOverflow(index);
     } else {
-      if (!ap_.c)
+      if (!ap_.c) {
         ap_.c = c;
+        ap_.edge = next_edge;
+      }
 
       ++ap_.length;
 
-      if (prev_created && ap_.node != &root_)
-        prev_created->suffix_link = ap_.node;
+      if (prev_created != kNoNode && ap_.node != kRootId)
+        nodes_[prev_created].suffix_link = ap_.node;
 
-      prev_created = nullptr;
+      prev_created = kNoNode;
 
       FixLengthOverflow(index);
       break;
@@ -174,37 +399,241 @@ void SuffixTree::AddSymbol(char c, size_t index) {
   }
 }
 
-void SuffixTree::FinishString(Node &from) {
-  for (auto &it : from.to) {
-    if (!it.second.end.has_value())
-      it.second.end = s_.size();
+std::optional<std::pair<NodeId, size_t>> SuffixTree::Locate(std::string_view pattern) const {
+  NodeId node = kRootId;
+  size_t depth = 0;
+
+  while (depth < pattern.size()) {
+    NodeId child = FindChild(node, pattern[depth]);
 
-    FinishString(*it.second.node);
+    if (child == kNoNode)
+      return std::nullopt;
+
+    size_t edge_length = EdgeLength(child);
+    size_t compare_length = std::min(edge_length, pattern.size() - depth);
+
+    if (s_.compare(nodes_[child].start, compare_length, pattern.substr(depth, compare_length)) != 0)
+      return std::nullopt;
+
+    node = child;
+    depth += edge_length;
   }
+
+  return std::make_pair(node, depth);
 }
 
-void SuffixTree::PrintTree(std::ostream &out, size_t first_size) {
-  std::cout << node_count_ << '\n';
-  size_t node_id = 0;
-  PrintNode(root_, out, first_size, node_id);
+bool SuffixTree::Contains(std::string_view pattern) const {
+  return Locate(pattern).has_value();
 }
 
-void SuffixTree::PrintNode(Node &from,
-                           std::ostream &out,
-                           size_t first_size,
-                           size_t &node_id) {
-  from.id = node_id;
-  ++node_id;
+template<typename Visitor>
+void SuffixTree::ForEachOccurrence(std::string_view pattern, Visitor visitor) const {
+  auto located = Locate(pattern);
 
-  for (const auto &it : from.to) {
-    bool from_first = it.second.start < first_size;
+  if (!located)
+    return;
+
+  //                    node  , string depth
+  std::vector<std::pair<NodeId, size_t>> stack{*located};
+
+  while (!stack.empty()) {
+    auto[node, depth] = stack.back();
+    stack.pop_back();
+
+    if (nodes_[node].first_child == kNoNode && node != kRootId)
+      visitor(s_.size() - depth);
+
+    for (NodeId child = nodes_[node].first_child; child != kNoNode; child = nodes_[child].next_sibling)
+      stack.emplace_back(child, depth + EdgeLength(child));
+  }
+
+  // The last remainder_ suffixes are still implicit, they don't have their own leaves
+  for (size_t start = s_.size() - remainder_; start < s_.size(); ++start)
+    if (s_.compare(start, pattern.size(), pattern) == 0)
+      visitor(start);
+}
+
+size_t SuffixTree::CountOccurrences(std::string_view pattern) const {
+  size_t count = 0;
+  ForEachOccurrence(pattern, [&count](size_t) { ++count; });
+  return count;
+}
+
+std::vector<size_t> SuffixTree::FindOccurrences(std::string_view pattern) const {
+  std::vector<size_t> result;
+  ForEachOccurrence(pattern, [&result](size_t start) { result.push_back(start); });
+  return result;
+}
+
+struct PrintFrame {
+  // id in the order of printing
+  size_t id;
+  NodeId next_child;
+};
+
+// Pre-order with an explicit stack, the depth of the tree can be as big as the string
+template<typename Visitor>
+void SuffixTree::ForEachEdge(Visitor visitor) const {
+  size_t node_id = 0;
+  std::vector<PrintFrame> stack{{node_id++, nodes_[kRootId].first_child}};
+
+  while (!stack.empty()) {
+    NodeId child = stack.back().next_child;
+
+    if (child == kNoNode) {
+      stack.pop_back();
+      continue;
+    }
+
+    stack.back().next_child = nodes_[child].next_sibling;
+
+    visitor(EdgeRow{stack.back().id, nodes_[child].start, EdgeEnd(child)});
+    stack.push_back({node_id++, nodes_[child].first_child});
+  }
+}
+
+void SuffixTree::PrintTree(std::ostream &out, size_t first_size) const {
+  out << nodes_.size() << '\n';
+  ForEachEdge([&out, first_size](const EdgeRow &row) {
+    bool from_first = row.start < first_size;
     size_t str_id = from_first ? 0 : 1;
-    size_t start = from_first ? it.second.start : it.second.start - first_size;
-    size_t end = from_first ? std::min(it.second.end.value(), first_size) : it.second.end.value()
-        - first_size;
-    out << from.id << ' ' << str_id << ' ' << start << ' ' << end << '\n';
-    PrintNode(*it.second.node, out, first_size, node_id);
+    size_t start = from_first ? row.start : row.start - first_size;
+    size_t end = from_first ? std::min(row.end, first_size) : row.end - first_size;
+    out << row.parent_id << ' ' << str_id << ' ' << start << ' ' << end << '\n';
+  });
+}
+
+void BinaryWriter::WriteInteger(uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i)
+    buffer_.push_back(static_cast<char>(value >> (8 * i)));
+
+  if (buffer_.size() >= kBufferSize)
+    Flush();
+}
+
+void BinaryWriter::WriteBytes(std::string_view bytes) {
+  Flush();
+  out_.write(bytes.data(), bytes.size());
+}
+
+void BinaryWriter::Flush() {
+  out_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+size_t BinaryReader::ReadStream(char *data, size_t size) {
+  in_.read(data, size);
+  size_t read = in_.gcount();
+  expected_ -= std::min<uint64_t>(expected_, read);
+  return read;
+}
+
+void BinaryReader::Refill(size_t bytes) {
+  size_ -= position_;
+  std::copy(buffer_.begin() + position_, buffer_.begin() + position_ + size_, buffer_.begin());
+  position_ = 0;
+  size_t ahead = std::min<uint64_t>(buffer_.size() - size_, expected_);
+  size_ += ReadStream(buffer_.data() + size_, std::max(bytes - size_, ahead));
+}
+
+uint64_t BinaryReader::ReadInteger(size_t bytes) {
+  if (size_ - position_ < bytes)
+    Refill(bytes);
+
+  if (size_ - position_ < bytes) {
+    failed_ = true;
+    position_ = size_;
+    return 0;
+  }
+
+  uint64_t value = 0;
+
+  for (size_t i = 0; i < bytes; ++i)
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(buffer_[position_ + i])) << (8 * i);
+
+  position_ += bytes;
+  return value;
+}
+
+// Grows the result by chunks, so that a broken size fails at the end of the stream instead of allocating it
+std::string BinaryReader::ReadBytes(size_t size) {
+  size_t buffered = std::min<size_t>(size, size_ - position_);
+  std::string result(buffer_.begin() + position_, buffer_.begin() + position_ + buffered);
+  position_ += buffered;
+
+  while (result.size() < size) {
+    size_t chunk = std::min(kBufferSize, size - result.size());
+    result.resize(result.size() + chunk);
+
+    if (ReadStream(result.data() + result.size() - chunk, chunk) != chunk) {
+      failed_ = true;
+      return {};
+    }
+  }
+
+  return result;
+}
+
+// Layout: u64 text size, text, u64 remainder, u32 node count,
+// then a row of three u32 (parent id, start, end) per edge
+void SuffixTree::WriteBinary(std::ostream &out) const {
+  BinaryWriter writer(out);
+  writer.WriteInteger(s_.size(), sizeof(uint64_t));
+  writer.WriteBytes(s_);
+  writer.WriteInteger(remainder_, sizeof(uint64_t));
+  writer.WriteInteger(nodes_.size(), sizeof(uint32_t));
+  ForEachEdge([&writer](const EdgeRow &row) {
+    writer.WriteInteger(row.parent_id, sizeof(uint32_t));
+    writer.WriteInteger(row.start, sizeof(uint32_t));
+    writer.WriteInteger(row.end, sizeof(uint32_t));
+  });
+}
+
+// Rows come in pre-order, so the parent of every edge is already there.
+// Ends of the leaves are restored as open
+std::optional<SuffixTree> SuffixTree::ReadBinary(std::istream &in) {
+  constexpr size_t kRowBytes = 3 * sizeof(uint32_t);
+
+  BinaryReader reader(in);
+  SuffixTree tree;
+  tree.has_suffix_links_ = false;
+  uint64_t text_size = reader.ReadInteger(sizeof(uint64_t));
+
+  // Offsets are stored as u32 and kOpenEnd is reserved
+  if (reader.Failed() || text_size >= kOpenEnd)
+    return std::nullopt;
+
+  tree.s_ = reader.ReadBytes(text_size);
+  tree.remainder_ = reader.ReadInteger(sizeof(uint64_t));
+  size_t node_count = reader.ReadInteger(sizeof(uint32_t));
+
+  // A suffix tree has at most 2n nodes besides the root
+  if (reader.Failed() || tree.remainder_ > text_size || node_count == 0 || node_count > 2 * text_size + 1)
+    return std::nullopt;
+
+  reader.Expect((node_count - 1) * kRowBytes);
+  tree.nodes_.reserve(node_count);
+  tree.edges_.Reserve(node_count, tree.nodes_);
+
+  for (size_t id = 1; id < node_count; ++id) {
+    size_t parent = reader.ReadInteger(sizeof(uint32_t));
+    size_t start = reader.ReadInteger(sizeof(uint32_t));
+    size_t end = reader.ReadInteger(sizeof(uint32_t));
+
+    if (reader.Failed() || parent >= id || start >= end || end > text_size ||
+        tree.FindChild(parent, tree.s_[start]) != kNoNode)
+      return std::nullopt;
+
+    NodeId child = tree.NewNode(tree.s_[start], start, end);
+
+    tree.AddChild(parent, child);
   }
+
+  for (size_t id = 1; id < node_count; ++id)
+    if (tree.nodes_[id].first_child == kNoNode)
+      tree.nodes_[id].end = kOpenEnd;
+
+  return tree;
 }
 
 int main() {
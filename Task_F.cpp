@@ -4,171 +4,344 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
+#include <string>
+#include <string_view>
 #include <tuple>
-#include <optional>
-#include <map>
-#include <set>
-#include <memory>
-
-struct Node;
-
-struct Transition {
-  Transition() = default;
-  explicit Transition(std::unique_ptr<Node> &&node,
-                      size_t start,
-                      std::optional<size_t> end)
-      : node(std::move(node)), start(start), end(end) {}
+#include <limits>
+#include <cstdint>
+
+using NodeId = uint32_t;
+// Letters are their own chars and the terminator of the string i is -1 - i, so there is no limit
+// on the number of strings, terminators go before letters and 0 is never a symbol of the text
+using Symbol = int32_t;
+
+constexpr NodeId kRootId = 0;
+constexpr NodeId kNoNode = std::numeric_limits<NodeId>::max();
+constexpr uint32_t kOpenEnd = std::numeric_limits<uint32_t>::max();
+constexpr Symbol kNoSymbol = 0;
+constexpr size_t kWordBits = 64;
+
+// Every node except the root stores the edge leading into it,
+// children form a doubly linked list sorted by the first symbol of their edges
+struct Node {
+  Node() = default;
+  Node(Symbol c, uint32_t start, uint32_t end) : c(c), start(start), end(end) {}
 
-  size_t Length() const { return end.value() - start; }
+  size_t Length() const { return end - start; }
 
-  std::unique_ptr<Node> node = nullptr;
+  Symbol c = kNoSymbol;
   // [start, end)
-  size_t start = 0;
-  std::optional<size_t> end = std::nullopt;
-};
-
-struct Node {
-  std::map<char, Transition> to;
-  Node *suffix_link = nullptr;
+  uint32_t start = 0;
+  uint32_t end = kOpenEnd;
+  NodeId suffix_link = kNoNode;
+  NodeId first_child = kNoNode;
+  NodeId next_sibling = kNoNode;
+  NodeId prev_sibling = kNoNode;
+  // number of strings, that have a suffix in the subtree
+  uint32_t coverage = 0;
   size_t common_count = 0;
 };
 
 struct ActivePoint {
-  Node *node = nullptr;
-  // c == \0 <=> length = 0 and that we don't have an edge to go to
-  char c = '\0';
+  NodeId node = kRootId;
+  // c == kNoSymbol <=> length = 0 and that we don't have an edge to go to
+  Symbol c = kNoSymbol;
+  // the child of node, that the edge by c leads to, cached to not look it up on every step
+  NodeId edge = kNoNode;
   size_t length = 0;
 };
 
-class SuffixTree {
+// Open addressing from (node, first symbol of the edge) to the child. An entry keeps only the two
+// ids and the symbol is checked on the child, which the caller reads right after anyway, so a search
+// is about one cache miss instead of a walk over the siblings spread across the pool
+class EdgeTable {
  public:
-  explicit SuffixTree(const std::string &s) : s_(s) {
-    ap_.node = &root_;
-    Initialize();
+  EdgeTable() { Rehash(16, {}); }
+
+  NodeId Find(NodeId from, Symbol c, const std::vector<Node> &nodes) const {
+    for (size_t i = Slot(from, c);; i = (i + 1) & (entries_.size() - 1)) {
+      if (entries_[i].from == from && nodes[entries_[i].child].c == c)
+        return entries_[i].child;
+
+      if (entries_[i].from == kNoNode)
+        return kNoNode;
+    }
+  }
+
+  // Adds the edge or redirects it, if from already has one by the symbol of child
+  void Set(NodeId from, NodeId child, const std::vector<Node> &nodes) {
+    if (4 * (size_ + 1) > 3 * entries_.size())
+      Rehash(2 * entries_.size(), nodes);
+
+    Symbol c = nodes[child].c;
+    size_t i = Slot(from, c);
+
+    for (; entries_[i].from != kNoNode; i = (i + 1) & (entries_.size() - 1))
+      if (entries_[i].from == from && nodes[entries_[i].child].c == c)
+        break;
+
+    if (entries_[i].from == kNoNode)
+      ++size_;
+
+    entries_[i] = {from, child};
   }
 
-  void ComputeCommonStrings(size_t first_length);
-  std::string FindKthCommon(size_t k);
+  void Reserve(size_t size, const std::vector<Node> &nodes) {
+    size_t capacity = entries_.size();
+
+    while (3 * capacity < 4 * size)
+      capacity *= 2;
+
+    if (capacity != entries_.size())
+      Rehash(capacity, nodes);
+  }
+
+ private:
+  struct Entry {
+    NodeId from = kNoNode;
+    NodeId child = kNoNode;
+  };
+
+  // The top bits of the Fibonacci hash, the capacity is a power of two
+  size_t Slot(NodeId from, Symbol c) const {
+    return ((static_cast<uint64_t>(from) << 32 | static_cast<uint32_t>(c)) * 0x9e3779b97f4a7c15ULL) >> shift_;
+  }
+
+  void Rehash(size_t capacity, const std::vector<Node> &nodes) {
+    std::vector<Entry> entries(capacity);
+    entries.swap(entries_);
+    shift_ = 64;
+
+    for (size_t i = capacity; i > 1; i /= 2)
+      --shift_;
+
+    for (const Entry &entry : entries)
+      if (entry.from != kNoNode) {
+        size_t i = Slot(entry.from, nodes[entry.child].c);
+
+        for (; entries_[i].from != kNoNode; i = (i + 1) & (entries_.size() - 1)) {}
+
+        entries_[i] = entry;
+      }
+  }
+
+  std::vector<Entry> entries_;
+  size_t size_ = 0;
+  int shift_ = 64;
+};
+
+// Generalized suffix tree: string i is terminated with its own symbol -1 - i
+class SuffixTree {
+ public:
+  explicit SuffixTree(const std::vector<std::string> &strings);
+
+  // Common strings are the ones, that occur in at least min_strings of the strings
+  void ComputeCommonStrings(size_t min_strings);
+  // 0-indexed in lexicographic order among the common strings from the last ComputeCommonStrings.
+  // Answers point into the tree's own text, empty if there is no such string
+  std::string_view FindKthCommon(size_t k) const;
+  // Answers all the sorted ks in a single descent
+  std::vector<std::string_view> FindKthCommon(const std::vector<size_t> &sorted_ks) const;
+  std::string FindLongestCommon(size_t min_strings) const;
 
  private:
   void Initialize();
-  void AddSymbol(char c, size_t index);
-  void FinishString(Node &from);
-  bool NeedToSplit(char c) const;
+  void ComputeCoverage();
+  size_t StringOf(size_t index) const;
+  // Length of the part of the edge, that doesn't cross a terminator
+  size_t CommonLength(NodeId node) const;
+
+  NodeId NewNode(Symbol c, size_t start, size_t end);
+  NodeId FindChild(NodeId from, Symbol c) const;
+  // Puts child between the siblings prev and next, kNoNode for the ends of the list
+  void LinkChild(NodeId from, NodeId prev, NodeId child, NodeId next);
+  void AddChild(NodeId from, NodeId child);
+  void ReplaceChild(NodeId from, NodeId old_child, NodeId new_child);
+
+  void SetActiveEdge(Symbol c);
+  NodeId NextEdge(Symbol c) const;
+  void AddSymbol(Symbol c, size_t index);
+  void FinishString();
+  bool NeedToSplit(Symbol c, NodeId next_edge) const;
   void FixLengthOverflow(size_t index);
 
-  std::tuple<bool, bool> ComputeCommonStrings(Node &from,
-                                              size_t first_length,
-                                              size_t to_start,
-                                              size_t to_end);
-
-  const std::string &s_;
-  Node root_{};
+  std::vector<Symbol> text_;
+  // The same text as chars for the answers, terminators are never a part of one
+  std::string s_;
+  // string_ends_[i] - position right after the terminator of the string i
+  std::vector<size_t> string_ends_;
+  // nodes_[kRootId] is the root
+  std::vector<Node> nodes_;
+  // The same edges as the sibling lists, which keep the children sorted for the traversals
+  EdgeTable edges_;
   ActivePoint ap_{};
   size_t remainder_ = 0;
-  size_t node_count_ = 0;
 };
 
+SuffixTree::SuffixTree(const std::vector<std::string> &strings) {
+  for (size_t i = 0; i < strings.size(); ++i) {
+    for (char c : strings[i])
+      text_.push_back(static_cast<unsigned char>(c));
+
+    text_.push_back(-1 - static_cast<Symbol>(i));
+    s_ += strings[i];
+    s_ += '$';
+    string_ends_.push_back(s_.size());
+  }
+
+  Initialize();
+  ComputeCoverage();
+}
+
 void SuffixTree::Initialize() {
-  ++node_count_;
+  // A suffix tree has at most 2n nodes, usually a lot less
+  nodes_.reserve(s_.size() + s_.size() / 2 + 1);
+  edges_.Reserve(nodes_.capacity(), nodes_);
+  nodes_.emplace_back(kNoSymbol, 0, 0);
 
-  for (size_t i = 0; i < s_.size(); ++i)
-    AddSymbol(s_[i], i);
+  for (size_t i = 0; i < text_.size(); ++i)
+    AddSymbol(text_[i], i);
 
-  FinishString(root_);
+  FinishString();
 }
 
-bool SuffixTree::NeedToSplit(char c) const {
+NodeId SuffixTree::NewNode(Symbol c, size_t start, size_t end) {
+  nodes_.emplace_back(c, start, end);
+  return nodes_.size() - 1;
+}
+
+NodeId SuffixTree::FindChild(NodeId from, Symbol c) const {
+  return edges_.Find(from, c, nodes_);
+}
+
+void SuffixTree::LinkChild(NodeId from, NodeId prev, NodeId child, NodeId next) {
+  nodes_[child].prev_sibling = prev;
+  nodes_[child].next_sibling = next;
+
+  if (prev == kNoNode)
+    nodes_[from].first_child = child;
+  else
+    nodes_[prev].next_sibling = child;
+
+  if (next != kNoNode)
+    nodes_[next].prev_sibling = child;
+}
+
+void SuffixTree::AddChild(NodeId from, NodeId child) {
+  NodeId prev = kNoNode;
+  NodeId next = nodes_[from].first_child;
+
+  while (next != kNoNode && nodes_[next].c < nodes_[child].c) {
+    prev = next;
+    next = nodes_[next].next_sibling;
+  }
+
+  LinkChild(from, prev, child, next);
+  edges_.Set(from, child, nodes_);
+}
+
+// No walk over the siblings, the old child knows its neighbours
+void SuffixTree::ReplaceChild(NodeId from, NodeId old_child, NodeId new_child) {
+  edges_.Set(from, new_child, nodes_);
+  LinkChild(from, nodes_[old_child].prev_sibling, new_child, nodes_[old_child].next_sibling);
+  nodes_[old_child].prev_sibling = kNoNode;
+  nodes_[old_child].next_sibling = kNoNode;
+}
+
+void SuffixTree::SetActiveEdge(Symbol c) {
+  ap_.c = c;
+  ap_.edge = c ? FindChild(ap_.node, c) : kNoNode;
+}
+
+// The edge, that c would be added to, kNoNode if there is none
+NodeId SuffixTree::NextEdge(Symbol c) const {
+  return ap_.c ? ap_.edge : FindChild(ap_.node, c);
+}
+
+bool SuffixTree::NeedToSplit(Symbol c, NodeId next_edge) const {
   if (ap_.c)
-    return s_[ap_.node->to.at(ap_.c).start + ap_.length] != c;
+    return text_[nodes_[next_edge].start + ap_.length] != c;
   else
-    return ap_.node->to.find(c) == ap_.node->to.end();
+    return next_edge == kNoNode;
 }
 
 void SuffixTree::FixLengthOverflow(size_t index) {
-  while (ap_.c && ap_.node->to[ap_.c].end.has_value()
-      && ap_.length > ap_.node->to[ap_.c].end.value() - ap_.node->to[ap_.c].start) {
-    ActivePoint new_ap{};
-    size_t node_len = ap_.node->to[ap_.c].Length();
-    char next_c = s_[index - ap_.length + node_len];
-    new_ap.node = ap_.node->to[ap_.c].node.get();
-    new_ap.length = ap_.length - node_len;
-    new_ap.c = next_c;
-    ap_ = new_ap;
+  while (ap_.c && nodes_[ap_.edge].end != kOpenEnd && ap_.length > nodes_[ap_.edge].Length()) {
+    size_t node_len = nodes_[ap_.edge].Length();
+    ap_.node = ap_.edge;
+    ap_.length -= node_len;
+    SetActiveEdge(text_[index - ap_.length]);
   }
 
-  if (ap_.c) {
-    Transition &to_c = ap_.node->to[ap_.c];
-
-    if (to_c.end.has_value() && ap_.length == to_c.end.value() - to_c.start) {
-      ap_.node = to_c.node.get();
-      ap_.length = 0;
-      ap_.c = '\0';
-    }
+  if (ap_.c && nodes_[ap_.edge].end != kOpenEnd && ap_.length == nodes_[ap_.edge].Length()) {
+    ap_.node = ap_.edge;
+    ap_.length = 0;
+    ap_.c = kNoSymbol;
+    ap_.edge = kNoNode;
   }
 }
 
-void SuffixTree::AddSymbol(char c, size_t index) {
+void SuffixTree::AddSymbol(Symbol c, size_t index) {
   ++remainder_;
-  Node *prev_created = nullptr;
+  NodeId prev_created = kNoNode;
 
   while (remainder_ > 0) {
-    if (NeedToSplit(c)) {
-      if (ap_.c) {
-        Transition &to_c = ap_.node->to[ap_.c];
+    NodeId next_edge = NextEdge(c);
 
-        size_t split_end = to_c.start + ap_.length;
+    if (NeedToSplit(c, next_edge)) {
+      if (ap_.c) {
+        NodeId to_c = next_edge;
 
-        auto other_node = std::make_unique<Node>();
-        to_c.node.swap(other_node);
-        to_c.node->to.emplace(
-            std::make_pair(s_[split_end], Transition(std::move(other_node), split_end, to_c.end))
-        );
-        to_c.end = split_end;
-        to_c.node->to.emplace(
-            std::make_pair(c, Transition(std::make_unique<Node>(), index, std::nullopt))
-        );
+        size_t split_end = nodes_[to_c].start + ap_.length;
 
-        node_count_ += 2;
+        NodeId middle = NewNode(ap_.c, nodes_[to_c].start, split_end);
+        NodeId leaf = NewNode(c, index, kOpenEnd);
+        ReplaceChild(ap_.node, to_c, middle);
+        nodes_[to_c].c = text_[split_end];
+        nodes_[to_c].start = split_end;
+        AddChild(middle, to_c);
+        AddChild(middle, leaf);
 
-        if (prev_created)
-          prev_created->suffix_link = to_c.node.get();
+        if (prev_created != kNoNode)
+          nodes_[prev_created].suffix_link = middle;
 
-        prev_created = to_c.node.get();
+        prev_created = middle;
       } else {
-        ap_.node->to.emplace(
-            std::make_pair(c, Transition(std::make_unique<Node>(), index, std::nullopt))
-        );
-        ++node_count_;
+        NodeId leaf = NewNode(c, index, kOpenEnd);
+        AddChild(ap_.node, leaf);
 
-        if (prev_created && ap_.node != &root_)
-          prev_created->suffix_link = ap_.node;
+        if (prev_created != kNoNode && ap_.node != kRootId)
+          nodes_[prev_created].suffix_link = ap_.node;
 
-        prev_created = nullptr;
+        prev_created = kNoNode;
       }
 
       --remainder_;
 
-      if (ap_.node == &root_) {
+      if (ap_.node == kRootId) {
         if (ap_.length > 0)
           --ap_.length;
 
-        ap_.c = ap_.length ? s_[index - remainder_ + 1] : '\0';
+        SetActiveEdge(ap_.length ? text_[index - remainder_ + 1] : kNoSymbol);
       } else {
-        ap_.node = ap_.node->suffix_link ? ap_.node->suffix_link : &root_;
+        NodeId link = nodes_[ap_.node].suffix_link;
+        ap_.node = link != kNoNode ? link : kRootId;
+        SetActiveEdge(ap_.c);
       }
 
       FixLengthOverflow(index);
     } else {
-      if (!ap_.c)
+      if (!ap_.c) {
         ap_.c = c;
+        ap_.edge = next_edge;
+      }
 
       ++ap_.length;
 
-      if (prev_created && ap_.node != &root_)
-        prev_created->suffix_link = ap_.node;
+      if (prev_created != kNoNode && ap_.node != kRootId)
+        nodes_[prev_created].suffix_link = ap_.node;
 
-      prev_created = nullptr;
+      prev_created = kNoNode;
 
       FixLengthOverflow(index);
       break;
@@ -176,100 +349,215 @@ void SuffixTree::AddSymbol(char c, size_t index) {
   }
 }
 
-void SuffixTree::FinishString(Node &from) {
-  for (auto &it : from.to) {
-    if (!it.second.end.has_value())
-      it.second.end = s_.size();
+// Open edges are exactly the leaves, so there is no need to walk the tree
+void SuffixTree::FinishString() {
+  for (Node &node : nodes_)
+    if (node.end == kOpenEnd)
+      node.end = text_.size();
+}
 
-    FinishString(*it.second.node);
-  }
+size_t SuffixTree::StringOf(size_t index) const {
+  return std::upper_bound(string_ends_.begin(), string_ends_.end(), index) - string_ends_.begin();
 }
 
-void SuffixTree::ComputeCommonStrings(size_t first_length) {
-  ComputeCommonStrings(root_, first_length, 0, 0);
+size_t SuffixTree::CommonLength(NodeId node) const {
+  // Terminators are unique, so only leaf edges can contain them
+  if (nodes_[node].first_child != kNoNode)
+    return nodes_[node].Length();
+
+  return string_ends_[StringOf(nodes_[node].start)] - 1 - nodes_[node].start;
 }
 
-std::tuple<bool, bool> SuffixTree::ComputeCommonStrings(Node &from,
-                                                        size_t first_length,
-                                                        size_t to_start,
-                                                        size_t to_end) {
-  from.common_count = 0;
-
-  bool has_first = false;
-  bool has_second = false;
-
-  for (auto &it : from.to) {
-    if (it.second.node->to.empty()) {
-      if (it.second.start < first_length)
-        has_first = true;
-      else
-        has_second = true;
+struct PostOrderFrame {
+  NodeId node;
+  NodeId next_child;
+};
+
+// Post-order with an explicit stack, the depth of the tree can be as big as the string.
+// Every frame owns a bitset of strings met in its subtree, so the memory is O(depth * strings)
+void SuffixTree::ComputeCoverage() {
+  size_t words = (string_ends_.size() + kWordBits - 1) / kWordBits;
+  std::vector<PostOrderFrame> stack{{kRootId, nodes_[kRootId].first_child}};
+  std::vector<uint64_t> stack_strings(words);
+
+  while (!stack.empty()) {
+    NodeId child = stack.back().next_child;
+    uint64_t *strings = stack_strings.data() + (stack.size() - 1) * words;
+
+    if (child == kNoNode) {
+      NodeId done = stack.back().node;
+      nodes_[done].coverage = 0;
+
+      for (size_t i = 0; i < words; ++i) {
+        nodes_[done].coverage += __builtin_popcountll(strings[i]);
+
+        if (stack.size() > 1)
+          strings[i - words] |= strings[i];
+      }
+
+      stack.pop_back();
+      stack_strings.resize(stack.size() * words);
+      continue;
+    }
+
+    stack.back().next_child = nodes_[child].next_sibling;
+
+    if (nodes_[child].first_child == kNoNode) {
+      size_t string_id = StringOf(nodes_[child].start);
+      strings[string_id / kWordBits] |= 1ull << (string_id % kWordBits);
+      nodes_[child].coverage = 1;
     } else {
-      auto[first, second] = ComputeCommonStrings(*it.second.node,
-                                                 first_length,
-                                                 it.second.start,
-                                                 it.second.end.value());
-      has_first = has_first || first;
-      has_second = has_second || second;
-
-      if (first && second)
-        from.common_count += it.second.node->common_count;
+      stack.push_back({child, nodes_[child].first_child});
+      stack_strings.resize(stack.size() * words);
+    }
+  }
+}
+
+void SuffixTree::ComputeCommonStrings(size_t min_strings) {
+  nodes_[kRootId].common_count = 0;
+  std::vector<PostOrderFrame> stack{{kRootId, nodes_[kRootId].first_child}};
+
+  while (!stack.empty()) {
+    NodeId child = stack.back().next_child;
+
+    if (child == kNoNode) {
+      NodeId done = stack.back().node;
+      stack.pop_back();
+
+      if (!stack.empty())
+        nodes_[stack.back().node].common_count += nodes_[done].common_count;
+
+      continue;
     }
+
+    stack.back().next_child = nodes_[child].next_sibling;
+    // Coverage only shrinks going down, so there is nothing common below
+    bool is_common = nodes_[child].coverage >= min_strings;
+    nodes_[child].common_count = is_common ? CommonLength(child) : 0;
+
+    if (is_common && nodes_[child].first_child != kNoNode)
+      stack.push_back({child, nodes_[child].first_child});
+    else
+      nodes_[stack.back().node].common_count += nodes_[child].common_count;
   }
+}
+
+std::string SuffixTree::FindLongestCommon(size_t min_strings) const {
+  size_t best_end = 0;
+  size_t best_length = 0;
+  //                    node  , string depth
+  std::vector<std::pair<NodeId, size_t>> stack{{kRootId, 0}};
+
+  while (!stack.empty()) {
+    auto[node, depth] = stack.back();
+    stack.pop_back();
+
+    for (NodeId child = nodes_[node].first_child; child != kNoNode; child = nodes_[child].next_sibling) {
+      if (nodes_[child].coverage < min_strings)
+        continue;
 
-  if (&from != &root_ && has_first && has_second)
-    from.common_count += to_end - to_start;
+      size_t child_depth = depth + CommonLength(child);
 
-  return {has_first, has_second};
+      if (child_depth > best_length) {
+        best_length = child_depth;
+        best_end = nodes_[child].start + CommonLength(child);
+      }
+
+      if (nodes_[child].first_child != kNoNode)
+        stack.emplace_back(child, child_depth);
+    }
+  }
+
+  return s_.substr(best_end - best_length, best_length);
 }
 
-// first string starts at 0
-std::string SuffixTree::FindKthCommon(size_t k) {
-  if (k >= root_.common_count)
-    return "";
+std::string_view SuffixTree::FindKthCommon(size_t k) const {
+  if (k >= nodes_[kRootId].common_count)
+    return {};
 
-  std::string result;
-  Node *cur = &root_;
-  size_t to_start = 0;
-  size_t to_end = 0;
+  NodeId cur = kRootId;
+  // string depth at the start of the edge into cur
+  size_t depth = 0;
+  size_t edge_length = 0;
 
   while (true) {
-    // invariant: k < cur->common_count
-    for (const auto &it : cur->to)
-      if (k < it.second.node->common_count) {
-        cur = it.second.node.get();
-        result += s_.substr(to_start, to_end - to_start);
-        to_start = it.second.start;
-        to_end = it.second.end.value();
+    // invariant: k < nodes_[cur].common_count
+    for (NodeId child = nodes_[cur].first_child; child != kNoNode; child = nodes_[child].next_sibling)
+      if (k < nodes_[child].common_count) {
+        cur = child;
+        depth += edge_length;
+        edge_length = CommonLength(child);
         break;
       } else {
-        k -= it.second.node->common_count;
+        k -= nodes_[child].common_count;
       }
 
-    if (k < to_end - to_start)
-      return result + s_.substr(to_start, k + 1);
+    if (k < edge_length)
+      return std::string_view(s_).substr(nodes_[cur].start - depth, depth + k + 1);
     else
-      k -= to_end - to_start;
+      k -= edge_length;
   }
 }
 
+struct KthFrame {
+  NodeId node;
+  NodeId next_child;
+  // index of the first common string in the subtree of next_child
+  size_t next_index;
+  // string depth at the end of the edge into node
+  size_t depth;
+};
+
+std::vector<std::string_view> SuffixTree::FindKthCommon(const std::vector<size_t> &sorted_ks) const {
+  std::vector<std::string_view> result(sorted_ks.size());
+  size_t query = 0;
+  std::vector<KthFrame> stack{{kRootId, nodes_[kRootId].first_child, 0, 0}};
+
+  while (!stack.empty() && query < sorted_ks.size()) {
+    KthFrame &from = stack.back();
+    NodeId child = from.next_child;
+
+    if (child == kNoNode) {
+      stack.pop_back();
+      continue;
+    }
+
+    size_t child_index = from.next_index;
+    size_t depth = from.depth;
+    from.next_child = nodes_[child].next_sibling;
+    from.next_index += nodes_[child].common_count;
+
+    if (sorted_ks[query] >= from.next_index)
+      continue;
+
+    size_t edge_length = CommonLength(child);
+    size_t edge_start = nodes_[child].start - depth;
+
+    while (query < sorted_ks.size() && sorted_ks[query] < child_index + edge_length) {
+      result[query] = std::string_view(s_).substr(edge_start, depth + sorted_ks[query] - child_index + 1);
+      ++query;
+    }
+
+    if (query < sorted_ks.size() && sorted_ks[query] < child_index + nodes_[child].common_count)
+      stack.push_back({child, nodes_[child].first_child, child_index + edge_length, depth + edge_length});
+  }
+
+  return result;
+}
+
 int main() {
   std::ios_base::sync_with_stdio(false);
   std::string s;
   std::string t;
   std::cin >> s >> t;
-  s += "$";
-  t += "#";
 
   size_t k;
   std::cin >> k;
   --k;
 
-  std::string combined = s + t;
-
-  SuffixTree suffix_tree(combined);
-  suffix_tree.ComputeCommonStrings(s.size());
-  std::string result = suffix_tree.FindKthCommon(k);
+  SuffixTree suffix_tree({s, t});
+  suffix_tree.ComputeCommonStrings(2);
+  std::string_view result = suffix_tree.FindKthCommon(k);
 
   if (result.empty())
     std::cout << "-1\n";
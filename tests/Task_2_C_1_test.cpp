@@ -0,0 +1,46 @@
+// The slab-parallel hull against the sequential one
+#define main TaskMain
+#include "../Task_2_C_1.cpp"
+#undef main
+
+#include <cstdlib>
+
+void Check(bool condition, const std::string &what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << '\n';
+    std::exit(1);
+  }
+}
+
+std::vector<Vector> RandomPoints(size_t n, std::mt19937 &gen) {
+  std::uniform_int_distribution<Coordinate> coordinate(-1000000, 1000000);
+  std::vector<Vector> points(n);
+
+  for (size_t i = 0; i < n; ++i)
+    points[i] = {coordinate(gen), coordinate(gen), coordinate(gen), static_cast<int>(i)};
+
+  return points;
+}
+
+void CheckParallel(size_t n, size_t threads_count, std::mt19937 &gen) {
+  std::vector<Vector> points = RandomPoints(n, gen);
+  Check(FormatHull(BuildConvexHullParallel(points, threads_count)) == FormatHull(BuildConvexHullIncremental(points)),
+        std::to_string(n) + " points in " + std::to_string(threads_count) + " slabs");
+}
+
+int main() {
+  std::mt19937 gen(42);
+
+  // The chunk of 5 leaves the sixth slab empty
+  CheckParallel(25, 6, gen);
+
+  for (size_t n : {4, 7, 25, 26, 97, 1000, 1001})
+    for (size_t threads_count : {0, 1, 2, 3, 5, 6, 7, 16, 64})
+      CheckParallel(n, threads_count, gen);
+
+  // Less than a tetrahedron
+  for (size_t n = 0; n < 4; ++n)
+    Check(!IncrementalHull(RandomPoints(n, gen)).Build(), std::to_string(n) + " points make no tetrahedron");
+
+  std::cout << "OK\n";
+}
@@ -0,0 +1,166 @@
+// Collisions of convex polygons, points and segments against checking every pair of their edges
+#define main TaskMain
+#include "../Task_2_D_2.cpp"
+#undef main
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <cstdlib>
+
+void Check(bool condition, const std::string &what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << '\n';
+    std::exit(1);
+  }
+}
+
+std::string ToString(const std::vector<Vector> &polygon) {
+  std::string result;
+
+  for (const Vector &p : polygon)
+    result += "(" + std::to_string(p.x) + ", " + std::to_string(p.y) + ")";
+
+  return result;
+}
+
+// Counter clockwise, without collinear points: a single point or a segment for the degenerate sets
+std::vector<Vector> ConvexHull(std::vector<Vector> points) {
+  std::sort(points.begin(), points.end(), [](const Vector &left, const Vector &right) {
+    return left.x < right.x || (left.x == right.x && left.y < right.y);
+  });
+  points.erase(std::unique(points.begin(), points.end(), [](const Vector &left, const Vector &right) {
+    return left.x == right.x && left.y == right.y;
+  }), points.end());
+
+  if (points.size() < 3)
+    return points;
+
+  std::vector<Vector> hull(2 * points.size());
+  size_t size = 0;
+
+  for (int pass = 0; pass < 2; ++pass) {
+    size_t lower_size = size;
+
+    for (const Vector &p : points) {
+      while (size >= lower_size + 2 && (hull[size - 1] - hull[size - 2]).Cross(p - hull[size - 2]) <= 0)
+        --size;
+
+      hull[size++] = p;
+    }
+
+    --size;
+    std::reverse(points.begin(), points.end());
+  }
+
+  hull.resize(size);
+  return hull;
+}
+
+long double PointSegmentDistance(const Vector &p, const Vector &a, const Vector &b) {
+  Vector edge = b - a;
+  Vector to_p = p - a;
+
+  if (edge.Dot(edge) == 0 || edge.Dot(to_p) <= 0)
+    return to_p.Length();
+
+  if (edge.Dot(to_p) >= edge.Dot(edge))
+    return (p - b).Length();
+
+  __int128 cross = edge.Cross(to_p);
+  return (cross < 0 ? -cross : cross) / edge.Length();
+}
+
+bool OnSegment(const Vector &p, const Vector &a, const Vector &b) {
+  return (b - a).Cross(p - a) == 0 && (p - a).Dot(p - b) <= 0;
+}
+
+bool SegmentsIntersect(const Vector &a, const Vector &b, const Vector &c, const Vector &d) {
+  int c_side = (b - a).CrossSign(c - a);
+  int d_side = (b - a).CrossSign(d - a);
+  int a_side = (d - c).CrossSign(a - c);
+  int b_side = (d - c).CrossSign(b - c);
+
+  if (c_side * d_side < 0 && a_side * b_side < 0)
+    return true;
+
+  return OnSegment(c, a, b) || OnSegment(d, a, b) || OnSegment(a, c, d) || OnSegment(b, c, d);
+}
+
+// Strictly for the polygons with an area, the flat ones are covered by their edges
+bool Inside(const Vector &p, const std::vector<Vector> &polygon) {
+  __int128 area = 0;
+
+  for (size_t i = 0; i < polygon.size(); ++i)
+    area += polygon[i].Cross(polygon[(i + 1) % polygon.size()]);
+
+  if (area == 0)
+    return false;
+
+  for (size_t i = 0; i < polygon.size(); ++i)
+    if ((polygon[(i + 1) % polygon.size()] - polygon[i]).CrossSign(p - polygon[i]) < 0)
+      return false;
+
+  return true;
+}
+
+void CheckCollision(const std::vector<Vector> &first, const std::vector<Vector> &second) {
+  ConvexPolygonSet set;
+  Collision collision = set.Collide(set.Add(first), set.Add(second));
+  std::string what = ToString(first) + " and " + ToString(second);
+
+  bool intersect = Inside(first[0], second) || Inside(second[0], first);
+  long double distance = INFINITY;
+
+  for (size_t i = 0; i < first.size(); ++i)
+    for (size_t j = 0; j < second.size(); ++j) {
+      const Vector &a = first[i];
+      const Vector &b = first[(i + 1) % first.size()];
+      const Vector &c = second[j];
+      const Vector &d = second[(j + 1) % second.size()];
+
+      intersect = intersect || SegmentsIntersect(a, b, c, d);
+      distance = std::min({distance, PointSegmentDistance(a, c, d), PointSegmentDistance(c, a, b)});
+    }
+
+  Check(collision.intersect == intersect, "intersect of " + what);
+
+  if (intersect)
+    Check(collision.distance == 0, "distance of the intersecting " + what);
+  else
+    Check(std::abs(collision.distance - distance) <= 1e-9l * (1 + distance), "distance of " + what);
+}
+
+int main() {
+  // The difference of these has no area, it used to be taken as containing the origin
+  CheckCollision({{0, 0}}, {{5, 5}});
+  CheckCollision({{0, 0}, {1, 0}}, {{5, 0}});
+  CheckCollision({{0, 0}, {1, 0}}, {{3, 0}, {7, 0}});
+  CheckCollision({{0, 0}, {1, 1}}, {{2, 2}, {3, 3}});
+  CheckCollision({{0, 0}, {1, 0}, {2, 0}}, {{5, 0}});
+  CheckCollision({{0, 0}}, {{0, 0}});
+  CheckCollision({{0, 0}, {4, 0}}, {{2, 0}});
+  CheckCollision({{0, 0}, {4, 0}}, {{4, 0}, {6, 0}});
+  CheckCollision({{0, 0}, {4, 0}}, {{2, -1}, {2, 1}});
+
+  std::mt19937 gen(42);
+
+  for (int test = 0; test < 20000; ++test) {
+    std::vector<Vector> polygons[2];
+
+    for (std::vector<Vector> &polygon : polygons) {
+      std::vector<Vector> points(gen() % 5 + 1);
+      Coordinate range = gen() % 2 ? 3 : 10;
+
+      for (Vector &p : points)
+        p = {static_cast<Coordinate>(gen() % (2 * range + 1)) - range,
+             static_cast<Coordinate>(gen() % (2 * range + 1)) - range};
+
+      polygon = ConvexHull(points);
+    }
+
+    CheckCollision(polygons[0], polygons[1]);
+  }
+
+  std::cout << "OK\n";
+}
@@ -0,0 +1,106 @@
+// The input reader on extreme integers and the binary points,
+// the parallel radix sort of the sweep events against std::sort,
+// and the sweep over all the intersecting pairs against checking every pair
+#define main TaskMain
+#include "../Task_2_E.cpp"
+#undef main
+
+#include <random>
+#include <cstdlib>
+
+void Check(bool condition, const std::string &what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << '\n';
+    std::exit(1);
+  }
+}
+
+void CheckInputReader() {
+  std::FILE *text = std::tmpfile();
+  std::fputs("-9223372036854775808 9223372036854775807 -0 -17 -2147483648", text);
+  std::rewind(text);
+  InputReader text_reader(text);
+  Check(text_reader.ReadInteger<Coordinate>() == std::numeric_limits<Coordinate>::min(), "LLONG_MIN");
+  Check(text_reader.ReadInteger<Coordinate>() == std::numeric_limits<Coordinate>::max(), "LLONG_MAX");
+  Check(text_reader.ReadInteger<Coordinate>() == 0, "-0");
+  Check(text_reader.ReadInteger<Coordinate>() == -17, "-17");
+  Check(text_reader.ReadInteger<int>() == std::numeric_limits<int>::min(), "INT_MIN");
+  std::fclose(text);
+
+  std::vector<Vector> points = {{0, 0}, {-1, 1}, {std::numeric_limits<Coordinate>::min(), 258},
+                                {std::numeric_limits<Coordinate>::max(), -65536}};
+  std::FILE *binary = std::tmpfile();
+  auto write = [binary](uint64_t value) {
+    for (int i = 0; i < 8; ++i)
+      std::fputc(static_cast<int>(value >> (8 * i) & 0xff), binary);
+  };
+  write(points.size());
+
+  for (const Vector &p : points) {
+    write(p.x);
+    write(p.y);
+  }
+
+  std::rewind(binary);
+  InputReader binary_reader(binary);
+  Check(ReadBinaryPoints(binary_reader) == points, "binary points");
+  std::fclose(binary);
+}
+
+void CheckRadixSort(size_t size, size_t threads_count, std::mt19937_64 &gen) {
+  std::vector<uint64_t> keys(size);
+
+  for (uint64_t &key : keys)
+    key = gen() >> (gen() % 64);
+
+  std::vector<uint64_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  ParallelRadixSort(keys, threads_count);
+  Check(keys == expected, std::to_string(size) + " keys in " + std::to_string(threads_count) + " threads");
+}
+
+void CheckIntersections(size_t size, Coordinate range, std::mt19937_64 &gen) {
+  std::uniform_int_distribution<Coordinate> coordinate(-range, range);
+  std::vector<Segment> segments;
+
+  for (size_t i = 0; i < size; ++i)
+    segments.emplace_back(Vector{coordinate(gen), coordinate(gen)}, Vector{coordinate(gen), coordinate(gen)}, i);
+
+  std::vector<std::pair<int, int>> expected;
+
+  for (size_t i = 0; i < size; ++i)
+    for (size_t j = i + 1; j < size; ++j)
+      if (segments[i].Intersects(segments[j]))
+        expected.emplace_back(i, j);
+
+  std::vector<std::pair<int, int>> found;
+  ForEachIntersection(segments, [&found](int first, int second) {
+    found.emplace_back(std::min(first, second), std::max(first, second));
+  });
+  std::sort(found.begin(), found.end());
+  Check(found == expected, std::to_string(size) + " segments within " + std::to_string(range));
+}
+
+int main() {
+  CheckInputReader();
+  std::mt19937_64 gen(42);
+
+  // More threads than chunks, the idle ones used to keep the counts of the previous pass
+  CheckRadixSort(1 << 16, 1000, gen);
+
+  for (size_t size : {0, 1, 2, 17, 1000, 65537, 5 * 65536 + 1})
+    for (size_t threads_count : {0, 1, 3, 6, 8, 1000})
+      CheckRadixSort(size, threads_count, gen);
+
+  // Small ranges give a lot of shared end points, overlaps and vertical segments
+  for (Coordinate range : {3, 20, 1000000000})
+    for (int test = 0; test < 20; ++test)
+      CheckIntersections(60, range, gen);
+
+  // Beyond kMaxSweepCoordinate the sweep would overflow, these go through the check of every pair
+  for (Coordinate range : {kMaxSweepCoordinate + 1, Coordinate(1) << 60})
+    for (int test = 0; test < 5; ++test)
+      CheckIntersections(60, range, gen);
+
+  std::cout << "OK\n";
+}
@@ -0,0 +1,94 @@
+// Round trip of the suffix tree through the binary format
+#define main TaskMain
+#include "../Task_E.cpp"
+#undef main
+
+#include <sstream>
+#include <random>
+#include <cstdlib>
+
+void Check(bool condition, const std::string &what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << '\n';
+    std::exit(1);
+  }
+}
+
+// Broken data must be rejected or at least give a tree, that can be queried safely
+void CheckCorrupted(const std::string &s) {
+  std::stringstream binary;
+  SuffixTree(s).WriteBinary(binary);
+  std::string bytes = binary.str();
+
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    std::istringstream cut(bytes.substr(0, size));
+    Check(!SuffixTree::ReadBinary(cut).has_value(), "ReadBinary of " + s + " cut at " + std::to_string(size));
+  }
+
+  for (size_t i = 0; i < bytes.size(); ++i)
+    for (int bit = 0; bit < 8; ++bit) {
+      std::string flipped = bytes;
+      flipped[i] ^= static_cast<char>(1 << bit);
+      std::istringstream in(flipped);
+      std::optional<SuffixTree> loaded = SuffixTree::ReadBinary(in);
+
+      if (loaded.has_value())
+        for (size_t from = 0; from < s.size(); ++from)
+          loaded->CountOccurrences(std::string_view(s).substr(from));
+    }
+}
+
+void CheckRoundTrip(const std::string &s, size_t first_size) {
+  SuffixTree tree(s);
+  std::stringstream binary;
+  tree.WriteBinary(binary);
+  std::optional<SuffixTree> read = SuffixTree::ReadBinary(binary);
+  Check(read.has_value(), "ReadBinary of " + s);
+  const SuffixTree &loaded = *read;
+
+  std::ostringstream printed, printed_loaded;
+  tree.PrintTree(printed, first_size);
+  loaded.PrintTree(printed_loaded, first_size);
+  Check(printed.str() == printed_loaded.str(), "PrintTree of " + s);
+
+  for (size_t from = 0; from < s.size(); ++from)
+    for (size_t length = 1; from + length <= s.size(); ++length) {
+      std::string_view pattern(s.data() + from, length);
+      Check(tree.CountOccurrences(pattern) == loaded.CountOccurrences(pattern),
+            "CountOccurrences(" + std::string(pattern) + ") in " + s);
+    }
+}
+
+int main() {
+  // An internal edge "abb..." crosses first_size, it used to be cut there
+  CheckRoundTrip("caccabbabbcac", 6);
+  std::stringstream binary;
+  SuffixTree("caccabbabbcac").WriteBinary(binary);
+  Check(SuffixTree::ReadBinary(binary)->CountOccurrences("abb") == 2, "CountOccurrences(abb) after the round trip");
+
+  CheckRoundTrip("abab#baba$", 5);
+  CheckCorrupted("caccabbabbcac");
+  CheckCorrupted("abab#baba$");
+
+  // The reader must not consume anything after the tree
+  std::stringstream with_trailer;
+  SuffixTree("caccabbabbcac").WriteBinary(with_trailer);
+  with_trailer << "TRAILER";
+  Check(SuffixTree::ReadBinary(with_trailer).has_value(), "ReadBinary before a trailer");
+  std::string trailer;
+  with_trailer >> trailer;
+  Check(trailer == "TRAILER", "the trailer after the tree");
+
+  std::mt19937 gen(42);
+
+  for (int test = 0; test < 200; ++test) {
+    std::string s(gen() % 30 + 1, 'a');
+
+    for (char &c : s)
+      c = static_cast<char>('a' + gen() % 3);
+
+    CheckRoundTrip(s, gen() % (s.size() + 1));
+  }
+
+  std::cout << "OK\n";
+}